@@ -36,18 +36,55 @@ SOURCES = \
     icons.cpp \
     iconmodel.cpp \
     icongrid.cpp \
+    iconrenderer.cpp \
+    thumbnailcache.cpp \
+    iconatlas.cpp \
+    svgsource.cpp \
+    compiledpath.cpp \
+    iconsearch.cpp \
+    globaliconlist.cpp \
+    iconlistpool.cpp \
+    iconexport.cpp \
+    spritesheet.cpp \
+    svgsprite.cpp \
+    pngstreamwriter.cpp \
+    benchmark.cpp \
     extrawidgets.cpp
 
 HEADERS = \
     icons.h \
     iconmodel.h \
     icongrid.h \
+    iconrenderer.h \
+    thumbnailcache.h \
+    iconatlas.h \
+    svgsource.h \
+    compiledpath.h \
+    iconsearch.h \
+    globaliconlist.h \
+    iconlistpool.h \
+    iconexport.h \
+    spritesheet.h \
+    svgsprite.h \
+    pngstreamwriter.h \
+    benchmark.h \
     extrawidgets.h
 
 RESOURCES = icons.qrc
 FORMS = icons.ui
 INCLUDEPATH +=
-LIBS +=
+
+# zlib for pngstreamwriter.cpp. Windows has no system copy: point ZLIB_DIR
+# (qmake argument or environment) at an install with include/ and lib/,
+# e.g. qmake6 ZLIB_DIR=C:/vcpkg/installed/x64-windows
+win32 {
+    isEmpty(ZLIB_DIR): ZLIB_DIR = $$(ZLIB_DIR)
+    isEmpty(ZLIB_DIR): error("zlib not found: set ZLIB_DIR to a zlib install, e.g. from vcpkg")
+    INCLUDEPATH += $$ZLIB_DIR/include
+    LIBS += -L$$ZLIB_DIR/lib -lzlib
+} else {
+    LIBS += -lz
+}
 
 # Include library resources (generated icon data)
 include(library/library.pri)
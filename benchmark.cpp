@@ -0,0 +1,246 @@
+#include "benchmark.h"
+#include "compiledpath.h"
+#include "iconlistpool.h"
+#include "iconrenderer.h"
+#include "svgsource.h"
+
+#include <QElapsedTimer>
+#include <QRegularExpression>
+#include <QTextStream>
+#include <QThread>
+#include <QThreadPool>
+
+#include <atomic>
+#include <functional>
+#include <vector>
+
+// Runs render(i) for i in [0, count) on threads workers; returns elapsed ns
+// and counts null images in *failed
+static qint64 timeParallel(int count, int threads, const std::function<QImage(int)> &render, int *failed) {
+	QThreadPool pool;
+	pool.setMaxThreadCount(threads);
+	std::atomic<int> next { 0 };
+	std::atomic<int> nulls { 0 };
+	QElapsedTimer timer;
+	timer.start();
+	for (int t = 0; t < threads; ++t) {
+		pool.start([&]() {
+			for (int i = next++; i < count; i = next++) {
+				if (render(i).isNull())
+					++nulls;
+			}
+		});
+	}
+	pool.waitForDone();
+	*failed = nulls;
+	return timer.nsecsElapsed();
+}
+
+// ============================================================================
+// Render paths
+// ============================================================================
+
+int runRenderBenchmark(const QStringList &arguments) {
+	QTextStream out(stdout);
+	const int at = arguments.indexOf("--benchmark-render");
+	const QString collectionId = arguments.value(at + 1, "tabler");
+	const int size = qMax(1, arguments.value(at + 2, "32").toInt());
+
+	const IconCollection *coll = IconCollectionRegistry::instance().findCollection(collectionId);
+	if (!coll) {
+		out << "Unknown collection " << collectionId << Qt::endl;
+		return 1;
+	}
+	IconListKey key;
+	key.collectionId = coll->id;
+	key.style = coll->hasStyle(IconStyle::Outline) ? IconStyle::Outline
+												   : coll->availableStyles().value(0, IconStyle::Outline);
+	key.size = coll->defaultSize();
+	IconListPool lists(1);
+	auto *list = dynamic_cast<SVGIconList*>(lists.acquire(key));
+	const auto *compiled = dynamic_cast<const CompiledPathSource*>(list);
+	if (!list || !compiled) {
+		out << collectionId << " has no compiled path records" << Qt::endl;
+		return 1;
+	}
+
+	// Same state IconModel::compiledIcon() and renderSource() produce with
+	// the default fill color and stroke slider
+	std::vector<CompiledIcon> icons;
+	std::vector<QByteArray> sources;
+	for (int i = 0; i < list->getCount(); ++i) {
+		CompiledIcon icon;
+		const char *scale = nullptr;
+		icon.paths = compiled->getCompiledPaths(i, &scale);
+		if (icon.paths.isEmpty())
+			continue;
+		icon.viewBox = list->getBaseSize();
+		icon.scale = scale ? QByteArray(scale).toFloat() : 0.0f;
+		icon.style = compiled->getCompiledStyle();
+		icons.push_back(std::move(icon));
+		sources.push_back(list->getSource(i).toUtf8());
+	}
+	if (icons.empty()) {
+		out << collectionId << " has no compiled icons" << Qt::endl;
+		return 1;
+	}
+
+	const int threads = QThread::idealThreadCount();
+	const int count = static_cast<int>(icons.size());
+	out << count << " of " << list->getCount() << " " << list->getLibraryName() << " icons compiled, "
+		<< size << " px, " << threads << " threads" << Qt::endl;
+
+	int svgFailed = 0;
+	int compiledFailed = 0;
+	const qint64 svgNs = timeParallel(count, threads, [&](int i) {
+		return IconRenderer::renderSvg(sources[i], size, Qt::transparent);
+	}, &svgFailed);
+	const qint64 compiledNs = timeParallel(count, threads, [&](int i) {
+		return renderCompiledIcon(icons[i], size, Qt::transparent);
+	}, &compiledFailed);
+
+	auto perCore = [&](qint64 ns) { return count * 1e9 / qMax<qint64>(1, ns) / threads; };
+	out << "renderSvg:          " << QString::number(perCore(svgNs), 'f', 0) << " thumbnails/s per core" << Qt::endl;
+	out << "renderCompiledIcon: " << QString::number(perCore(compiledNs), 'f', 0) << " thumbnails/s per core ("
+		<< QString::number(double(svgNs) / qMax<qint64>(1, compiledNs), 'f', 2) << "x)" << Qt::endl;
+	if (svgFailed || compiledFailed)
+		out << svgFailed << " SVG and " << compiledFailed << " compiled renders failed" << Qt::endl;
+	return (svgFailed || compiledFailed) ? 1 : 0;
+}
+
+// ============================================================================
+// SVG rewriter
+// ============================================================================
+
+// IconModel's stroke slider before rewriteSvg(), kept verbatim as the baseline
+static QString adjustStrokeWidth(const QString &svgSource, int sliderPos, bool fillBased) {
+	static QRegularExpression rx(QStringLiteral("stroke-width=\"([0-9.]+)\""));
+
+	if (fillBased) {
+		// Fill-based: replace stroke-width with absolute value
+		static const double absValues[] = { 0.0, 0.25, 0.5, 1.0, 1.25, 1.5 };
+		double newWidth = absValues[qBound(0, sliderPos, 5)];
+		QString result = svgSource;
+		result.replace(rx, QString("stroke-width=\"%1\"").arg(newWidth));
+		return result;
+	} else {
+		// Stroke-based: scale existing stroke-width values
+		if (sliderPos == 2)  // 1x scale, no change needed
+			return svgSource;
+
+		static const double scales[] = { 0.5, 0.75, 1.0, 1.25, 1.5 };
+		double scale = scales[qBound(0, sliderPos, 4)];
+
+		QString result = svgSource;
+		QRegularExpressionMatchIterator it = rx.globalMatch(svgSource);
+
+		// Process matches in reverse order to preserve positions
+		QList<QRegularExpressionMatch> matches;
+		while (it.hasNext())
+			matches.prepend(it.next());
+
+		for (const auto &match : matches) {
+			bool ok;
+			double width = match.captured(1).toDouble(&ok);
+			if (ok) {
+				double newWidth = width * scale;
+				if (newWidth < 0.25) newWidth = 0.25;  // Minimum stroke width
+				QString replacement = QString("stroke-width=\"%1\"").arg(newWidth);
+				result.replace(match.capturedStart(), match.capturedLength(), replacement);
+			}
+		}
+		return result;
+	}
+}
+
+// The chain IconModel ran before rewriteSvg(): entities, stroke slider, currentColor
+static QString legacyRewrite(const QString &source, const EntityMap &entities, const SvgRewriteOptions &options) {
+	QString result = source;
+	if (!entities.isEmpty())
+		result = SVGIconList::resolveEntities(result, entities);
+	result = adjustStrokeWidth(result, options.strokeSliderPos, options.fillBasedStroke);
+	if (!options.currentColor.isEmpty())
+		result.replace("currentColor", options.currentColor);
+	return result;
+}
+
+int runRewriteBenchmark(const QStringList &arguments) {
+	static const int c_rounds = 5;
+	QTextStream out(stdout);
+	const QString only = arguments.value(arguments.indexOf("--benchmark-rewrite") + 1);
+
+	struct Icon {
+		QString source;
+		EntityMap entities;
+	};
+	std::vector<Icon> icons;
+	IconListPool lists(1);
+	for (const auto &coll : IconCollectionRegistry::instance().collections()) {
+		if (!only.isEmpty() && coll.id != only)
+			continue;
+		IconListKey key;
+		key.collectionId = coll.id;
+		key.style = coll.hasStyle(IconStyle::Outline) ? IconStyle::Outline
+													  : coll.availableStyles().value(0, IconStyle::Outline);
+		key.size = coll.defaultSize();
+		auto *list = dynamic_cast<SVGIconList*>(lists.acquire(key));
+		if (!list)
+			continue;
+		for (int i = 0; i < list->getCount(); ++i)
+			icons.push_back({ list->getSource(i), list->getEntities(i) });
+		lists.trim();
+	}
+	if (icons.empty()) {
+		out << "No SVG icons" << (only.isEmpty() ? QString() : " in " + only) << Qt::endl;
+		return 1;
+	}
+	out << icons.size() << " icons, " << c_rounds << " rounds each" << Qt::endl;
+
+	// Both stroke modes, at the slider's default and at a changed position
+	const std::pair<int, bool> settings[] = { { 0, true }, { 3, true }, { 2, false }, { 4, false } };
+	int mismatches = 0;
+	for (const auto &[sliderPos, fillBased] : settings) {
+		SvgRewriteOptions options;
+		options.strokeSliderPos = sliderPos;
+		options.fillBasedStroke = fillBased;
+		options.currentColor = QStringLiteral("#336699");
+
+		QElapsedTimer timer;
+		qint64 legacyBytes = 0;
+		timer.start();
+		for (int round = 0; round < c_rounds; ++round) {
+			for (const Icon &icon : icons) {
+				options.entities = icon.entities.isEmpty() ? nullptr : &icon.entities;
+				legacyBytes += legacyRewrite(icon.source, icon.entities, options).toUtf8().size();
+			}
+		}
+		const qint64 legacyNs = timer.nsecsElapsed();
+
+		qint64 bytes = 0;
+		timer.restart();
+		for (int round = 0; round < c_rounds; ++round) {
+			for (const Icon &icon : icons) {
+				options.entities = icon.entities.isEmpty() ? nullptr : &icon.entities;
+				bytes += rewriteSvg(icon.source, options).size();
+			}
+		}
+		const qint64 rewriteNs = timer.nsecsElapsed();
+
+		int differ = 0;
+		for (const Icon &icon : icons) {
+			options.entities = icon.entities.isEmpty() ? nullptr : &icon.entities;
+			if (legacyRewrite(icon.source, icon.entities, options).toUtf8() != rewriteSvg(icon.source, options))
+				++differ;
+		}
+		mismatches += differ;
+
+		out << (fillBased ? "fill-based" : "stroke-based") << " slider " << sliderPos
+			<< ": regex chain " << QString::number(legacyNs / 1e6, 'f', 1) << " ms"
+			<< ", rewriteSvg " << QString::number(rewriteNs / 1e6, 'f', 1) << " ms"
+			<< " (" << QString::number(double(legacyNs) / qMax<qint64>(1, rewriteNs), 'f', 2) << "x)"
+			<< ", " << bytes / c_rounds / 1024 << " KB out"
+			<< (legacyBytes == bytes ? "" : ", sizes differ")
+			<< ", " << differ << " mismatches" << Qt::endl;
+	}
+	return mismatches ? 1 : 0;
+}
@@ -0,0 +1,18 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <QStringList>
+
+// "--benchmark-render [collection] [size]": renders every icon of the
+// collection that has a compiled path record through renderCompiledIcon()
+// and through IconRenderer::renderSvg() on all cores and prints thumbnails
+// per second per core for both. Needs a QGuiApplication; returns the exit code.
+int runRenderBenchmark(const QStringList &arguments);
+
+// "--benchmark-rewrite [collection]": times rewriteSvg() against the entity
+// resolution and regex chain it replaced over every icon of the SVG
+// collections and checks that both produce the same text. Prints to stdout;
+// returns the exit code.
+int runRewriteBenchmark(const QStringList &arguments);
+
+#endif // BENCHMARK_H
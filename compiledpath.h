@@ -0,0 +1,31 @@
+#ifndef COMPILEDPATH_H
+#define COMPILEDPATH_H
+
+#include <QByteArray>
+#include <QColor>
+#include <QImage>
+
+#include "library/lib_contentstore.h"
+
+// An icon's precompiled path record plus the state it is rendered with
+//
+// Records are written by generator.py for icons that only use plain shapes,
+// solid paints and transforms (see compile_svg_paths). Rendering one feeds
+// the stored commands straight into QPainterPath: no XML parsing and no
+// QSvgRenderer document per thumbnail.
+struct CompiledIcon {
+	QByteArray paths;            // Record from CompiledPathSource; empty = render the SVG
+	float viewBox = 24;          // Icon base size
+	float scale = 0;             // scale() wrapper of the body, 0 if none
+	CompiledPathStyle style;     // Paint inherited from the list's getSource() wrapper
+	QColor color = Qt::black;    // What "currentColor" resolves to
+	int strokeSliderPos = -1;
+	bool fillBasedStroke = true;
+
+	bool isNull() const { return paths.isEmpty(); }
+};
+
+// Thread-safe. Returns a null image if the record is malformed.
+QImage renderCompiledIcon(const CompiledIcon &icon, int size, const QColor &background);
+
+#endif // COMPILEDPATH_H
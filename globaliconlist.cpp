@@ -0,0 +1,164 @@
+#include "globaliconlist.h"
+
+#include <QBuffer>
+
+// Bitmap collections are shown at this size, or the closest available
+static const int c_preferredBitmapSize = 32;
+
+GlobalIconList::GlobalIconList() {
+	auto &registry = IconCollectionRegistry::instance();
+
+	for (const auto &coll : registry.collections()) {
+		IconStyle style = coll.hasStyle(IconStyle::Outline) ? IconStyle::Outline
+														   : coll.availableStyles().value(0, IconStyle::Outline);
+		addSource(coll.id, coll.displayName, style, coll.defaultSize(), false);
+	}
+
+	for (const auto &coll : registry.bitmapCollections()) {
+		int size = coll.defaultSize();
+		for (int candidate : coll.availableSizes) {
+			if (qAbs(candidate - c_preferredBitmapSize) < qAbs(size - c_preferredBitmapSize))
+				size = candidate;
+		}
+		addSource(coll.id, coll.displayName, IconStyle::Outline, size, true);
+	}
+}
+
+GlobalIconList::~GlobalIconList() = default;
+
+void GlobalIconList::addSource(const QString &id, const QString &displayName, IconStyle style,
+							   int size, bool bitmap) {
+	const QString styleName = bitmap ? QStringLiteral("Color") : iconStyleToString(style);
+	const IconCatalogEntry *entry = IconCollectionRegistry::catalogEntry(id, styleName, size, bitmap);
+	if (!entry)
+		return;
+
+	Source source;
+	source.collectionId = id;
+	source.displayName = displayName;
+	source.style = style;
+	source.size = size;
+	source.catalog = entry;
+
+	const int sourceIndex = static_cast<int>(m_sources.size());
+	m_sources.push_back(std::move(source));
+	m_entries.reserve(m_entries.size() + entry->count);
+	for (int index = 0; index < entry->count; ++index)
+		m_entries.push_back({ sourceIndex, index });
+}
+
+IconList *GlobalIconList::listFor(const Source &source) const {
+	if (!source.list) {
+		auto &registry = IconCollectionRegistry::instance();
+		if (source.catalog->bitmap)
+			source.list.reset(registry.createBitmapList(source.collectionId, source.size));
+		else
+			source.list.reset(registry.createIconList(source.collectionId, source.style, source.size));
+	}
+	return source.list.get();
+}
+
+QString GlobalIconList::getName(int index) const {
+	if (!isValidIndex(index))
+		return QString();
+	const Entry &entry = m_entries[index];
+	return IconNameTable(*m_sources[entry.source].catalog->name_table).nameString(entry.index);
+}
+
+bool GlobalIconList::isBitmap(int index) const {
+	return isValidIndex(index) && m_sources[m_entries[index].source].catalog->bitmap;
+}
+
+BitmapIconList *GlobalIconList::bitmapList(int index, int *localIndex) const {
+	if (!isBitmap(index))
+		return nullptr;
+	const Entry &entry = m_entries[index];
+	*localIndex = entry.index;
+	return static_cast<BitmapIconList*>(listFor(m_sources[entry.source]));
+}
+
+QString GlobalIconList::getBody(int index) const {
+	if (!isValidIndex(index))
+		return QString();
+	const Entry &entry = m_entries[index];
+	IconList *list = listFor(m_sources[entry.source]);
+	if (!list)
+		return QString();
+
+	if (list->isSVG())
+		return static_cast<SVGIconList*>(list)->getBody(entry.index);
+
+	// Bitmap: embed the PNG for "Copy SVG"; thumbnails come from bitmapList()
+	QPixmap pixmap = static_cast<BitmapIconList*>(list)->getPixmap(entry.index);
+	if (pixmap.isNull())
+		return QString();
+	QByteArray png;
+	QBuffer buffer(&png);
+	buffer.open(QIODevice::WriteOnly);
+	pixmap.save(&buffer, "PNG");
+	return QString("<image width=\"%1\" height=\"%2\" xlink:href=\"data:image/png;base64,%3\"/>")
+		.arg(pixmap.width()).arg(pixmap.height()).arg(QString::fromLatin1(png.toBase64()));
+}
+
+QString GlobalIconList::getSource(int index) const {
+	if (!isValidIndex(index))
+		return QString();
+	const Entry &entry = m_entries[index];
+	IconList *list = listFor(m_sources[entry.source]);
+	if (!list)
+		return QString();
+
+	if (list->isSVG()) {
+		auto *svg = static_cast<SVGIconList*>(list);
+		svg->setFillColor(m_fillColor);
+		return svg->getSource(entry.index);
+	}
+
+	const int size = m_sources[entry.source].size;
+	return QString("<svg viewBox=\"0 0 %1 %1\" xmlns=\"http://www.w3.org/2000/svg\" "
+				   "xmlns:xlink=\"http://www.w3.org/1999/xlink\">%2</svg>")
+		.arg(size).arg(getBody(index));
+}
+
+QStringList GlobalIconList::getTags(int index) const {
+	QStringList tags;
+	if (!isValidIndex(index))
+		return tags;
+	const Entry &entry = m_entries[index];
+	const IconCatalogEntry *catalog = m_sources[entry.source].catalog;
+	if (catalog->tags) {
+		for (int i = 0; i < 16 && catalog->tags[entry.index][i] != nullptr; ++i)
+			tags.append(QString::fromUtf8(catalog->tags[entry.index][i]));
+	}
+	return tags;
+}
+
+QString GlobalIconList::getCategory(int index) const {
+	if (!isValidIndex(index))
+		return QString();
+	const Entry &entry = m_entries[index];
+	const Source &source = m_sources[entry.source];
+	if (source.catalog->categories && source.catalog->categories[entry.index][0] != '\0')
+		return source.displayName + " / " + QString::fromUtf8(source.catalog->categories[entry.index]);
+	return source.displayName;
+}
+
+QString GlobalIconList::collectionId(int index) const {
+	return isValidIndex(index) ? m_sources[m_entries[index].source].collectionId : QString();
+}
+
+int GlobalIconList::localIndex(int index) const {
+	return isValidIndex(index) ? m_entries[index].index : -1;
+}
+
+IconListKey GlobalIconList::listKey(int index) const {
+	IconListKey key;
+	if (!isValidIndex(index))
+		return key;
+	const Source &source = m_sources[m_entries[index].source];
+	key.collectionId = source.collectionId;
+	key.style = source.style;
+	key.size = source.size;
+	key.bitmap = source.catalog->bitmap;
+	return key;
+}
@@ -0,0 +1,74 @@
+#ifndef GLOBALICONLIST_H
+#define GLOBALICONLIST_H
+
+#include <memory>
+#include <vector>
+
+#include "library/lib_svgiconlist.h"
+#include "iconlistpool.h"
+#include "iconmodel.h"
+
+// All registered collections presented as one SVG list, for global search
+//
+// Names, tags and categories come straight from the generated catalog, so
+// building the list constructs no IconList at all. The underlying lists are
+// created on first render of one of their icons. The model draws bitmap
+// icons from their own list (bitmapList()); getSource() wraps them in an SVG
+// <image> with a PNG data URI only for copying. Icons are ordered by collection.
+class GlobalIconList : public SVGIconList {
+public:
+	GlobalIconList();
+	~GlobalIconList() override;
+
+	static QString displayName() { return QStringLiteral("All Libraries"); }
+
+	int getCount() const override { return static_cast<int>(m_entries.size()); }
+	QString getName(int index) const override;
+	QString getBody(int index) const override;
+	QString getSource(int index) const override;
+
+	QColor getFillColor() const override { return m_fillColor; }
+	void setFillColor(QColor value) override { m_fillColor = value; }
+
+	QString getLibraryName() const override { return displayName(); }
+	int getBaseSize() const override { return 24; }
+
+	// Category is "<collection>" or "<collection> / <category>"
+	QStringList getTags(int index) const override;
+	QString getCategory(int index) const override;
+
+	// Collection of an icon and its index within that collection's list
+	QString collectionId(int index) const;
+	int localIndex(int index) const;
+	IconListKey listKey(int index) const;  // Key of the list localIndex() refers to
+
+	// Bitmap icons: the collection's list, created on demand, and the index in it
+	bool isBitmap(int index) const;
+	BitmapIconList *bitmapList(int index, int *localIndex) const;
+
+private:
+	struct Source {
+		QString collectionId;
+		QString displayName;
+		IconStyle style = IconStyle::Outline;
+		int size = 0;
+		const IconCatalogEntry *catalog = nullptr;
+		mutable std::unique_ptr<IconList> list;  // Created on demand
+	};
+
+	struct Entry {
+		int source;
+		int index;
+	};
+
+	void addSource(const QString &id, const QString &displayName, IconStyle style,
+				   int size, bool bitmap);
+	IconList *listFor(const Source &source) const;
+	bool isValidIndex(int index) const { return index >= 0 && index < getCount(); }
+
+	std::vector<Source> m_sources;
+	std::vector<Entry> m_entries;
+	QColor m_fillColor = clNone;
+};
+
+#endif // GLOBALICONLIST_H
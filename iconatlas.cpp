@@ -0,0 +1,101 @@
+#include "iconatlas.h"
+
+#include <QPainter>
+
+IconAtlas::IconAtlas(int pageSize, int maxPages)
+	: m_pageSize(pageSize)
+	, m_maxPages(qMax(1, maxPages))
+{
+}
+
+void IconAtlas::setSlotSize(int size) {
+	if (m_slotSize == size)
+		return;
+	clear();
+	m_slotSize = size;
+}
+
+void IconAtlas::setMaxPages(int pages) {
+	pages = qMax(1, pages);
+	if (pages < pageCount())
+		clear();  // Simpler than compacting; the thumbnails are re-rendered from cache
+	m_maxPages = pages;
+}
+
+QRect IconAtlas::slotRect(int id) const {
+	int n = id % slotsPerPage();
+	return QRect((n % slotsPerRow()) * m_slotSize, (n / slotsPerRow()) * m_slotSize,
+				 m_slotSize, m_slotSize);
+}
+
+bool IconAtlas::lookup(const IconRenderKey &key, const QImage **page, QRect *rect) {
+	auto it = m_slots.constFind(key);
+	if (it == m_slots.constEnd())
+		return false;
+	m_lru.splice(m_lru.begin(), m_lru, it->lru);
+	*page = &m_pages[it->id / slotsPerPage()];
+	*rect = slotRect(it->id);
+	return true;
+}
+
+bool IconAtlas::contains(const IconRenderKey &key) const {
+	return m_slots.contains(key);
+}
+
+int IconAtlas::allocateSlot() {
+	if (!m_freeSlots.empty()) {
+		int id = m_freeSlots.back();
+		m_freeSlots.pop_back();
+		return id;
+	}
+
+	if (pageCount() < m_maxPages) {
+		// New page; queue its slots in reverse so they fill top-left first
+		QImage page(m_pageSize, m_pageSize, QImage::Format_ARGB32_Premultiplied);
+		page.fill(Qt::transparent);
+		m_pages.push_back(page);
+		int first = (pageCount() - 1) * slotsPerPage();
+		for (int id = first + slotsPerPage() - 1; id > first; --id)
+			m_freeSlots.push_back(id);
+		return first;
+	}
+
+	// Atlas full: reuse the least recently used slot
+	if (m_lru.empty())
+		return -1;
+	auto victim = m_slots.find(m_lru.back());
+	int id = victim->id;
+	m_slots.erase(victim);
+	m_lru.pop_back();
+	return id;
+}
+
+bool IconAtlas::insert(const IconRenderKey &key, const QImage &image) {
+	if (m_slotSize <= 0 || m_slotSize > m_pageSize || image.size() != QSize(m_slotSize, m_slotSize))
+		return false;
+
+	int id;
+	auto existing = m_slots.find(key);
+	if (existing != m_slots.end()) {
+		id = existing->id;
+		m_lru.splice(m_lru.begin(), m_lru, existing->lru);
+	} else {
+		id = allocateSlot();
+		if (id < 0)
+			return false;
+		m_lru.push_front(key);
+		m_slots.insert(key, Slot { id, m_lru.begin() });
+	}
+
+	QPainter painter(&m_pages[id / slotsPerPage()]);
+	painter.setCompositionMode(QPainter::CompositionMode_Source);
+	painter.drawImage(slotRect(id).topLeft(), image);
+	return true;
+}
+
+void IconAtlas::clear() {
+	m_pages.clear();
+	m_freeSlots.clear();
+	m_lru.clear();
+	m_slots.clear();
+}
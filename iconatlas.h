@@ -0,0 +1,60 @@
+#ifndef ICONATLAS_H
+#define ICONATLAS_H
+
+#include <QHash>
+#include <QImage>
+#include <QRect>
+
+#include <list>
+#include <vector>
+
+#include "thumbnailcache.h"
+
+// Thumbnails packed into a few large image pages
+//
+// Every slot has the same size (the grid cell size), so pages are divided
+// into a fixed grid and allocation is a free-list pop. When all pages are
+// full the least recently used slot is reused. Changing the slot size drops
+// the whole atlas. GUI thread only.
+class IconAtlas {
+public:
+	explicit IconAtlas(int pageSize = 1024, int maxPages = 8);
+	IconAtlas(const IconAtlas &) = delete;
+	IconAtlas &operator=(const IconAtlas &) = delete;
+
+	void setSlotSize(int size);
+	int slotSize() const { return m_slotSize; }
+
+	void setMaxPages(int pages);
+	int maxPages() const { return m_maxPages; }
+	int pageCount() const { return static_cast<int>(m_pages.size()); }
+
+	// Page and source rect of a cached thumbnail; marks it as recently used
+	bool lookup(const IconRenderKey &key, const QImage **page, QRect *rect);
+	bool contains(const IconRenderKey &key) const;
+
+	// Returns false if the image does not match the slot size
+	bool insert(const IconRenderKey &key, const QImage &image);
+	void clear();
+
+private:
+	struct Slot {
+		int id = -1;
+		std::list<IconRenderKey>::iterator lru;
+	};
+
+	int slotsPerRow() const { return m_pageSize / m_slotSize; }
+	int slotsPerPage() const { return slotsPerRow() * slotsPerRow(); }
+	QRect slotRect(int id) const;
+	int allocateSlot();
+
+	int m_pageSize;
+	int m_maxPages;
+	int m_slotSize = 0;
+	std::vector<QImage> m_pages;
+	std::vector<int> m_freeSlots;
+	std::list<IconRenderKey> m_lru;  // Most recently used at the front
+	QHash<IconRenderKey, Slot> m_slots;
+};
+
+#endif // ICONATLAS_H
@@ -0,0 +1,885 @@
+#include "iconexport.h"
+#include "iconlistpool.h"
+#include "iconrenderer.h"
+#include "icons.h"
+#include "spritesheet.h"
+
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPainter>
+#include <QRegularExpression>
+#include <QSet>
+#include <QTextStream>
+#include <QThread>
+#include <QThreadPool>
+
+#include <atomic>
+#include <cstring>
+#include <functional>
+
+// Icon name usable as a file name
+static QString safeFileName(const QString &name) {
+	static const QRegularExpression unsafeChars("[/\\\\:*?\"<>|]");
+	return QString(name).replace(unsafeChars, "_");
+}
+
+// ============================================================================
+// IconExportJob
+// ============================================================================
+
+IconExportJob::IconExportJob(QObject *parent)
+	: QObject(parent)
+{
+	m_pool.setMaxThreadCount(QThread::idealThreadCount());
+	m_encoder.setMaxThreadCount(1);
+}
+
+IconExportJob::~IconExportJob() {
+	cancel();
+	m_pool.waitForDone();
+	m_encoder.waitForDone();
+}
+
+void IconExportJob::setScales(const QList<int> &scales) {
+	m_scales.clear();
+	for (int scale : scales) {
+		if (scale > 0 && !m_scales.contains(scale))
+			m_scales.append(scale);
+	}
+	if (m_scales.isEmpty())
+		m_scales.append(1);
+}
+
+// "icon.png" -> "icon@2x.png"; 1x keeps the path
+static QString scaledPath(const QString &path, int scale) {
+	if (scale == 1)
+		return path;
+	const int dot = path.lastIndexOf('.');
+	const QString suffix = QString("@%1x").arg(scale);
+	return dot > path.lastIndexOf('/') ? QString(path).insert(dot, suffix) : path + suffix;
+}
+
+// File names for an export into one folder: the icon name, then with style
+// and collection suffixes, then numbered, so no two tasks write one file.
+// Compared case-insensitively for case-insensitive file systems.
+static QStringList uniqueFileNames(const QList<ExportIconInfo> &icons) {
+	QStringList names;
+	names.reserve(icons.size());
+	QSet<QString> used;
+	for (const auto &info : icons) {
+		const QString name = safeFileName(info.name);
+		const QString style = info.style.isEmpty() ? QString() : "-" + safeFileName(info.style.toLower());
+		const QString styled = name + style;
+		const QString qualified = name + "-" + info.list.collectionId + style;
+		QString unique;
+		for (const QString &candidate : { name, styled, qualified }) {
+			if (!used.contains(candidate.toLower())) {
+				unique = candidate;
+				break;
+			}
+		}
+		for (int suffix = 2; unique.isEmpty(); ++suffix) {
+			const QString candidate = QString("%1-%2").arg(qualified).arg(suffix);
+			if (!used.contains(candidate.toLower()))
+				unique = candidate;
+		}
+		used.insert(unique.toLower());
+		names.append(unique);
+	}
+	return names;
+}
+
+// Bitmap list with the smallest icons that are still at least pixelSize,
+// so scaled exports start from the sharpest source
+static IconListKey bitmapListFor(const IconListKey &key, int pixelSize) {
+	const BitmapCollection *coll = IconCollectionRegistry::instance().findBitmapCollection(key.collectionId);
+	if (!coll)
+		return key;
+	IconListKey best = key;
+	for (int size : coll->availableSizes) {
+		const bool fits = size >= pixelSize;
+		const bool bestFits = best.size >= pixelSize;
+		if ((fits && (!bestFits || size < best.size)) || (!fits && !bestFits && size > best.size))
+			best.size = size;
+	}
+	return best;
+}
+
+// GUI thread time spent preparing icons before the event loop runs again
+static const int c_prepareSliceMs = 8;
+
+void IconExportJob::prepare(const QList<ExportIconInfo> &icons, int size,
+							const std::function<void(int, Icon &&)> &onIcon, const std::function<void()> &onDone) {
+	m_unavailable.clear();
+	m_preparation = std::make_unique<Preparation>();
+	m_preparation->icons = icons;
+	m_preparation->size = size;
+	m_preparation->onIcon = onIcon;
+	m_preparation->onDone = onDone;
+	prepareNext();
+}
+
+void IconExportJob::prepareNext() {
+	Preparation *preparation = m_preparation.get();
+	QElapsedTimer timer;
+	timer.start();
+	while (!m_cancelled && preparation->next < preparation->icons.size()
+		   && timer.elapsed() < c_prepareSliceMs) {
+		const int index = preparation->next++;
+		preparation->onIcon(index, prepareIcon(*preparation, preparation->icons[index]));
+	}
+	if (!m_cancelled && preparation->next < preparation->icons.size()) {
+		QMetaObject::invokeMethod(this, &IconExportJob::prepareNext, Qt::QueuedConnection);
+		return;
+	}
+	// Lists and the model are released before the export moves on
+	std::unique_ptr<Preparation> done = std::move(m_preparation);
+	done->onDone();
+}
+
+IconExportJob::Icon IconExportJob::prepareIcon(Preparation &preparation, const ExportIconInfo &info) {
+	Icon icon;
+	icon.fileName = safeFileName(info.name);
+	icon.background = info.backgroundColor;
+	icon.size = preparation.size > 0 ? preparation.size : info.size;
+
+	if (!info.list.bitmap && preparation.modelList != info.list) {
+		// The model lets go of its list before trim() may delete it
+		preparation.model.setIconList(nullptr);
+		preparation.modelList = IconListKey();
+		preparation.lists.trim();
+	}
+
+	IconListPool &pool = info.list.bitmap ? preparation.bitmapLists : preparation.lists;
+	IconList *list = pool.acquire(info.list);
+	if (!list || info.index < 0 || info.index >= list->getCount() || list->getName(info.index) != info.name) {
+		qWarning() << "Export: icon" << info.name << "is no longer available";
+		m_unavailable.append(info.name);
+		return icon;  // Fails when rendered
+	}
+
+	if (info.list.bitmap) {
+		// QPixmap is GUI thread only; scaling and background are done on the pool
+		for (int scale : m_scales) {
+			const int pixelSize = icon.size * scale;
+			IconList *source = preparation.bitmapLists.acquire(bitmapListFor(info.list, pixelSize));
+			if (!source || info.index >= source->getCount() || source->getName(info.index) != info.name)
+				source = preparation.bitmapLists.acquire(info.list);
+			if (auto *bitmap = dynamic_cast<BitmapIconList*>(source)) {
+				bitmap->setGrayscale(info.grayscale);
+				icon.images.insert(pixelSize, bitmap->getPixmap(info.index).toImage());
+			}
+		}
+		preparation.bitmapLists.trim();
+		return icon;
+	}
+
+	IconModel &model = preparation.model;
+	if (preparation.modelList != info.list) {
+		model.setIconList(list);
+		preparation.modelList = info.list;
+	}
+	model.setStrokeMode(info.fillBasedStroke);
+	model.setStrokeWidth(info.strokeWidth);
+	model.setFillColor(info.fillColor);
+	model.setToneColor(info.toneColor);
+	model.setBackgroundColor(info.backgroundColor);
+	// Reset entities an earlier entry of the same icon may have set
+	if (model.iconHasEntities(info.index)) {
+		model.setIconEntities(info.index, info.entities.isEmpty()
+								  ? model.getIconEntities(info.index) : info.entities);
+	}
+	icon.source = model.getIconRenderSource(info.index);
+	icon.svg = model.getIconSvg(info.index);
+	return icon;
+}
+
+QImage IconExportJob::renderIcon(const Icon &icon, int size) {
+	if (!icon.source.isEmpty())
+		return IconRenderer::renderSvg(icon.source, size, icon.background);
+
+	QImage image = icon.images.value(size);
+	if (image.isNull())
+		return image;
+	if (image.width() != size || image.height() != size)
+		image = image.scaled(size, size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+	if (icon.background.alpha() > 0) {
+		QImage withBackground(image.size(), QImage::Format_ARGB32_Premultiplied);
+		withBackground.fill(icon.background);
+		QPainter painter(&withBackground);
+		painter.drawImage(0, 0, image);
+		painter.end();
+		return withBackground;
+	}
+	return image;
+}
+
+void IconExportJob::start(int total) {
+	m_cancelled = false;
+	m_running = true;
+	m_total = total;
+	m_done = 0;
+	m_exported = 0;
+	m_onAllDone = nullptr;
+	emit progress(0, m_total);
+}
+
+void IconExportJob::run(const std::function<bool()> &task) {
+	m_pool.start([this, task]() {
+		const bool ok = !m_cancelled && task();
+		QMetaObject::invokeMethod(this, [this, ok]() { taskFinished(ok); }, Qt::QueuedConnection);
+	});
+}
+
+void IconExportJob::exportFiles(const QList<ExportIconInfo> &icons, const QString &folder, bool asPng, int size) {
+	// Files are written concurrently, so two icons must never share a path
+	const QStringList fileNames = uniqueFileNames(icons);
+	int total = 0;
+	for (const auto &info : icons)
+		total += (asPng || info.list.bitmap) ? m_scales.size() : 1;
+	start(total);
+	if (total == 0) {
+		finish();
+		return;
+	}
+
+	// Each icon is queued as soon as it is prepared
+	auto queued = std::make_shared<int>(0);
+	prepare(icons, size, [this, icons, fileNames, folder, asPng, queued](int index, Icon &&icon) {
+		icon.fileName = fileNames[index];
+		if (asPng || icons[index].list.bitmap) {
+			for (int scale : m_scales) {
+				const QString path = scaledPath(folder + "/" + icon.fileName + ".png", scale);
+				const int pixelSize = icon.size * scale;
+				run([icon, path, pixelSize]() {
+					const QImage image = renderIcon(icon, pixelSize);
+					return !image.isNull() && image.save(path, "PNG");
+				});
+				++*queued;
+			}
+		} else {
+			const QString path = folder + "/" + icon.fileName + ".svg";
+			const QByteArray svg = icon.svg.toUtf8();
+			run([svg, path]() {
+				QFile file(path);
+				return !svg.isEmpty() && file.open(QIODevice::WriteOnly | QIODevice::Text)
+					&& file.write(svg) == svg.size();
+			});
+			++*queued;
+		}
+	}, [this, queued]() {
+		skipTasks(m_total - *queued);
+	});
+}
+
+void IconExportJob::exportSpriteSheet(const QList<ExportIconInfo> &icons, const QString &filePath,
+										int size, int padding) {
+	auto sheet = std::make_unique<Sheet>();
+	sheet->filePath = filePath;
+	sheet->scales = m_scales;
+	const int count = static_cast<int>(icons.size());
+
+	// The layout only needs the sizes, so it does not wait for the sources
+	QList<QSize> sizes;
+	QStringList names;
+	for (const auto &info : icons) {
+		const int iconSize = size > 0 ? size : info.size;
+		sizes.append(QSize(iconSize, iconSize));
+		names.append(info.name);
+	}
+	sheet->layout = SpriteSheetLayout(sizes, padding);
+	sheet->keys = spriteKeys(names);
+	sheet->icons.resize(count);
+
+	start(count * sheet->scales.size());
+	if (count == 0) {
+		finish();
+		return;
+	}
+	m_sheet = std::move(sheet);
+	prepare(icons, size, [this](int index, Icon &&icon) {
+		m_sheet->icons[index] = std::move(icon);
+	}, [this]() {
+		if (m_cancelled)
+			finishSheet();
+		else
+			startSheetScale();
+	});
+}
+
+// ============================================================================
+// IconExportJob - streamed sprite sheet
+// ============================================================================
+
+static constexpr int SheetBandsInFlight = 3;
+
+void IconExportJob::startSheetScale() {
+	Sheet *sheet = m_sheet.get();
+	const int scale = sheet->scales[sheet->scaleIndex];
+	const QString path = scaledPath(sheet->filePath, scale);
+	const QSize size = sheet->layout.size(scale);
+
+	sheet->bands.assign(sheet->layout.rows().size(), SheetBand());
+	sheet->nextRender = 0;
+	sheet->nextEncode = 0;
+	sheet->encoded = 0;
+	if (!sheet->png.open(path, size.width(), size.height())) {
+		qWarning() << "Export: cannot write" << path << sheet->png.errorString();
+		sheet->failed = true;
+		finishSheet();
+		return;
+	}
+	sheet->imageFiles.append(QFileInfo(path).fileName());
+	renderSheetBands();
+}
+
+void IconExportJob::renderSheetBands() {
+	Sheet *sheet = m_sheet.get();
+	const int scale = sheet->scales[sheet->scaleIndex];
+	const auto &rows = sheet->layout.rows();
+	const int width = sheet->layout.size(scale).width();
+
+	while (!m_cancelled && !sheet->failed && sheet->nextRender < rows.size()
+		   && sheet->nextRender - sheet->encoded < SheetBandsInFlight) {
+		const int band = sheet->nextRender++;
+		const auto &row = rows[band];
+		QImage &image = sheet->bands[band].image;
+		image = QImage(width, row.height * scale, QImage::Format_RGBA8888);
+		if (image.isNull()) {
+			qWarning() << "Export: out of memory for a" << width << "x" << row.height * scale << "band";
+			sheet->failed = true;
+			break;
+		}
+		image.fill(Qt::transparent);
+
+		// Sprites of a band never overlap, so the tasks copy into it side by side
+		uchar *bits = image.bits();
+		const qsizetype bytesPerLine = image.bytesPerLine();
+		sheet->bands[band].pending = row.sprites.size();
+		for (int i : row.sprites) {
+			const QRect rect = sheet->layout.rect(i, scale).translated(0, -row.y * scale);
+			++sheet->busy;
+			m_pool.start([this, icon = &sheet->icons[i], rect, bits, bytesPerLine, band]() {
+				if (!m_cancelled) {
+					const QImage tile = renderIcon(*icon, rect.width()).convertToFormat(QImage::Format_RGBA8888);
+					// Bitmaps keep their aspect ratio and are centered in the rect
+					const int w = qMin(tile.width(), rect.width());
+					const int h = qMin(tile.height(), rect.height());
+					const int x = rect.x() + (rect.width() - w) / 2;
+					const int y = rect.y() + (rect.height() - h) / 2;
+					for (int line = 0; line < h; ++line)
+						std::memcpy(bits + (y + line) * bytesPerLine + x * 4, tile.constScanLine(line), w * 4);
+				}
+				QMetaObject::invokeMethod(this, [this, band]() { sheetSpriteRendered(band); }, Qt::QueuedConnection);
+			});
+		}
+	}
+	if (sheet->busy == 0)
+		finishSheet();
+}
+
+void IconExportJob::encodeSheetBands() {
+	Sheet *sheet = m_sheet.get();
+	while (sheet->nextEncode < sheet->nextRender && sheet->bands[sheet->nextEncode].pending == 0) {
+		const int band = sheet->nextEncode++;
+		const QImage image = sheet->bands[band].image;  // Shared, not copied
+		++sheet->busy;
+		m_encoder.start([this, sheet, image, band]() {
+			const bool ok = !m_cancelled
+				&& sheet->png.writeRows(image.constBits(), image.bytesPerLine(), image.height());
+			QMetaObject::invokeMethod(this, [this, band, ok]() { sheetBandEncoded(band, ok); }, Qt::QueuedConnection);
+		});
+	}
+}
+
+void IconExportJob::sheetSpriteRendered(int band) {
+	Sheet *sheet = m_sheet.get();
+	--sheet->busy;
+	++m_done;
+	emit progress(m_done, m_total);
+
+	if (--sheet->bands[band].pending == 0 && !m_cancelled && !sheet->failed)
+		encodeSheetBands();
+	else if ((m_cancelled || sheet->failed) && sheet->busy == 0)
+		finishSheet();
+}
+
+void IconExportJob::sheetBandEncoded(int band, bool ok) {
+	Sheet *sheet = m_sheet.get();
+	--sheet->busy;
+	++sheet->encoded;
+	sheet->bands[band].image = QImage();
+	if (!ok && !m_cancelled && !sheet->failed) {
+		qWarning() << "Export: failed to encode" << sheet->filePath << sheet->png.errorString();
+		sheet->failed = true;
+	}
+
+	if (m_cancelled || sheet->failed) {
+		if (sheet->busy == 0)
+			finishSheet();
+	} else if (sheet->encoded == static_cast<int>(sheet->bands.size())) {
+		++sheet->busy;
+		m_encoder.start([this, sheet]() {
+			const bool ok = sheet->png.close();
+			QMetaObject::invokeMethod(this, [this, ok]() { sheetWritten(ok); }, Qt::QueuedConnection);
+		});
+	} else {
+		renderSheetBands();
+	}
+}
+
+void IconExportJob::sheetWritten(bool ok) {
+	Sheet *sheet = m_sheet.get();
+	--sheet->busy;
+	const int scale = sheet->scales[sheet->scaleIndex];
+	const QFileInfo target(sheet->filePath);
+	const QString base = target.absolutePath() + "/" + target.completeBaseName();
+	if (!ok || !writeSpriteJson(scaledPath(base + ".json", scale), sheet->imageFiles.last(),
+								sheet->keys, sheet->layout, scale)) {
+		qWarning() << "Export: failed to write" << sheet->imageFiles.last() << sheet->png.errorString();
+		sheet->failed = true;
+	}
+
+	if (!sheet->failed && !m_cancelled && ++sheet->scaleIndex < sheet->scales.size())
+		startSheetScale();
+	else
+		finishSheet();
+}
+
+void IconExportJob::finishSheet() {
+	std::unique_ptr<Sheet> sheet = std::move(m_sheet);
+	sheet->png.abort();  // Only a sheet that was not completed is still open
+
+	const QFileInfo target(sheet->filePath);
+	const bool ok = !sheet->failed && !m_cancelled
+		&& writeSpriteCss(target.absolutePath() + "/" + target.completeBaseName() + ".css",
+						  sheet->imageFiles, sheet->scales, sheet->keys, sheet->layout);
+	m_exported = ok ? static_cast<int>(sheet->icons.size()) : 0;
+	finish();
+}
+
+void IconExportJob::exportSvgSprite(const QList<ExportIconInfo> &icons, const QString &filePath) {
+	const int count = static_cast<int>(icons.size());
+	start(count);
+	if (count == 0) {
+		finish();
+		return;
+	}
+	m_symbols.assign(count, SvgSpriteBuilder::Icon());
+	QStringList names;
+	for (const auto &info : icons)
+		names.append(info.name);
+
+	m_onAllDone = [this, filePath, names, count]() {
+		m_pool.start([this, filePath, names, count]() {
+			const QStringList keys = spriteKeys(names);
+			SvgSpriteBuilder builder;
+			// Symbol ids must stay the keys, whatever local ids come first
+			builder.reserveSymbolIds(keys);
+			for (int i = 0; i < count; ++i) {
+				if (m_symbols[i].valid)
+					builder.addIcon(keys[i], m_symbols[i]);
+			}
+			const QByteArray svg = builder.toSvg();
+			QFile file(filePath);
+			const bool ok = !m_cancelled && builder.count() > 0
+				&& file.open(QIODevice::WriteOnly) && file.write(svg) == svg.size();
+			const int exported = ok ? builder.count() : 0;
+			QMetaObject::invokeMethod(this, [this, exported]() {
+				m_symbols.clear();
+				m_exported = exported;
+				finish();
+			}, Qt::QueuedConnection);
+		});
+	};
+
+	// Icons are parsed in parallel as they are prepared; ids and shared defs
+	// are resolved in order once all are done
+	auto queued = std::make_shared<int>(0);
+	prepare(icons, 0, [this, queued](int index, Icon &&icon) {
+		SvgSpriteBuilder::Icon *symbol = &m_symbols[index];
+		run([svg = std::move(icon.svg), symbol]() {
+			if (!svg.isEmpty())
+				*symbol = SvgSpriteBuilder::parseIcon(svg);
+			return symbol->valid;
+		});
+		++*queued;
+	}, [this, queued]() {
+		skipTasks(m_total - *queued);
+	});
+}
+
+void IconExportJob::cancel() {
+	m_cancelled = true;
+}
+
+void IconExportJob::taskFinished(bool ok) {
+	++m_done;
+	if (ok)
+		++m_exported;
+	emit progress(m_done, m_total);
+	if (m_done < m_total)
+		return;
+
+	if (m_onAllDone && !m_cancelled) {
+		auto compose = std::move(m_onAllDone);
+		m_onAllDone = nullptr;
+		compose();
+	} else {
+		finish();
+	}
+}
+
+// Accounts for tasks a cancelled preparation never queued
+void IconExportJob::skipTasks(int count) {
+	if (count <= 0)
+		return;
+	m_done += count;
+	emit progress(m_done, m_total);
+	if (m_done == m_total)
+		finish();
+}
+
+void IconExportJob::finish() {
+	m_running = false;
+	m_onAllDone = nullptr;
+	m_symbols.clear();
+	emit finished(m_exported, m_total, m_cancelled);
+}
+
+// ============================================================================
+// Manifest
+// ============================================================================
+
+static bool parseColor(const QJsonValue &value, QColor *color, QString *error) {
+	if (value.isUndefined())
+		return true;
+	const QString text = value.toString();
+	if (text.compare(QLatin1String("none"), Qt::CaseInsensitive) == 0) {
+		*color = clNone;  // currentColor, as with "no fill" in the GUI
+		return true;
+	}
+	QColor parsed(text);
+	if (!parsed.isValid()) {
+		*error = QString("invalid color \"%1\"").arg(text);
+		return false;
+	}
+	*color = parsed;
+	return true;
+}
+
+static bool parseItem(const QJsonObject &object, IconExportItem *item, QString *error) {
+	item->collection = object.value("collection").toString();
+	if (item->collection.isEmpty()) {
+		*error = "missing \"collection\"";
+		return false;
+	}
+
+	const QString style = object.value("style").toString("Outline");
+	if (style.compare("Outline", Qt::CaseInsensitive) == 0)
+		item->style = IconStyle::Outline;
+	else if (style.compare("Filled", Qt::CaseInsensitive) == 0)
+		item->style = IconStyle::Filled;
+	else if (style.compare("TwoTone", Qt::CaseInsensitive) == 0)
+		item->style = IconStyle::TwoTone;
+	else {
+		*error = QString("unknown style \"%1\"").arg(style);
+		return false;
+	}
+
+	item->listSize = object.value("size").toInt(0);
+
+	const QJsonValue icons = object.value("icons");
+	if (icons.isString())
+		item->patterns.append(icons.toString());
+	for (const QJsonValue &pattern : icons.toArray())
+		item->patterns.append(pattern.toString());
+	if (item->patterns.isEmpty())
+		item->patterns.append("*");
+
+	const QJsonValue sizes = object.value("sizes");
+	if (sizes.isDouble())
+		item->sizes.append(sizes.toInt());
+	for (const QJsonValue &size : sizes.toArray())
+		item->sizes.append(size.toInt());
+	for (int size : item->sizes) {
+		if (size <= 0 || size > 4096) {
+			*error = QString("invalid size %1").arg(size);
+			return false;
+		}
+	}
+
+	if (!parseColor(object.value("fill"), &item->fillColor, error)
+		|| !parseColor(object.value("tone"), &item->toneColor, error)
+		|| !parseColor(object.value("background"), &item->backgroundColor, error))
+		return false;
+
+	item->strokeWidth = object.value("stroke").toInt(-1);
+	const QString strokeMode = object.value("strokeMode").toString();
+	if (strokeMode == "absolute")
+		item->fillBasedStroke = 1;
+	else if (strokeMode == "relative")
+		item->fillBasedStroke = 0;
+	else if (!strokeMode.isEmpty()) {
+		*error = QString("unknown strokeMode \"%1\"").arg(strokeMode);
+		return false;
+	}
+
+	const QJsonObject entities = object.value("entities").toObject();
+	for (auto it = entities.begin(); it != entities.end(); ++it)
+		item->entities[it.key()] = it.value().toString();
+
+	item->grayscale = object.value("grayscale").toBool(false);
+	item->format = object.value("format").toString(item->format).toLower();
+	if (item->format != "png" && item->format != "svg") {
+		*error = QString("unknown format \"%1\"").arg(item->format);
+		return false;
+	}
+	item->fileName = object.value("file").toString(item->fileName);
+	return true;
+}
+
+bool IconExportManifest::load(const QString &path, IconExportManifest *manifest, QString *error) {
+	QFile file(path);
+	if (!file.open(QIODevice::ReadOnly)) {
+		*error = QString("%1: %2").arg(path, file.errorString());
+		return false;
+	}
+
+	QJsonParseError parseError;
+	const QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &parseError);
+	if (!document.isObject()) {
+		*error = QString("%1: %2").arg(path, parseError.errorString());
+		return false;
+	}
+
+	const QJsonObject root = document.object();
+	manifest->outputDir = root.value("output").toString(".");
+	manifest->items.clear();
+	const QJsonArray items = root.value("items").toArray();
+	for (int i = 0; i < items.size(); ++i) {
+		IconExportItem item;
+		QString itemError;
+		if (!parseItem(items[i].toObject(), &item, &itemError)) {
+			*error = QString("%1: item %2: %3").arg(path).arg(i).arg(itemError);
+			return false;
+		}
+		manifest->items.push_back(std::move(item));
+	}
+	if (manifest->items.empty()) {
+		*error = QString("%1: no items").arg(path);
+		return false;
+	}
+	return true;
+}
+
+// ============================================================================
+// IconBatchExporter
+// ============================================================================
+
+IconBatchExporter::IconBatchExporter(const IconExportManifest &manifest)
+	: m_manifest(manifest)
+	, m_threads(QThread::idealThreadCount())
+{
+}
+
+void IconBatchExporter::setThreadCount(int threads) {
+	m_threads = qMax(1, threads);
+}
+
+bool IconBatchExporter::run() {
+	QTextStream err(stderr);
+	auto &registry = IconCollectionRegistry::instance();
+
+	QThreadPool pool;
+	pool.setMaxThreadCount(m_threads);
+	std::atomic<int> exported { 0 };
+	std::atomic<int> failed { 0 };
+
+	// Rendering and writing on the pool; the model and lists stay on this thread
+	auto write = [&](const QString &path, const std::function<bool(const QString &path)> &save) {
+		QDir().mkpath(QFileInfo(path).absolutePath());
+		pool.start([path, save, &exported, &failed]() {
+			if (save(path)) {
+				++exported;
+			} else {
+				++failed;
+				qWarning() << "Export: failed to write" << path;
+			}
+		});
+	};
+
+	QElapsedTimer timer;
+	timer.start();
+
+	IconListPool lists;
+	bool ok = true;
+	for (const IconExportItem &item : m_manifest.items) {
+		IconListKey key;
+		key.collectionId = item.collection;
+		key.style = item.style;
+		if (const BitmapCollection *bitmap = registry.findBitmapCollection(item.collection)) {
+			key.bitmap = true;
+			key.size = item.listSize > 0 ? item.listSize : bitmap->defaultSize();
+		} else if (const IconCollection *svg = registry.findCollection(item.collection)) {
+			key.size = item.listSize > 0 ? item.listSize : svg->defaultSize();
+		} else {
+			err << "Export: unknown collection " << item.collection << Qt::endl;
+			ok = false;
+			continue;
+		}
+		if (key.bitmap && item.format == "svg") {
+			err << "Export: " << item.collection << " is a bitmap collection, SVG export is not possible" << Qt::endl;
+			ok = false;
+			continue;
+		}
+
+		IconList *list = lists.acquire(key);
+		if (!list) {
+			err << "Export: no " << iconStyleToString(item.style) << " list of size " << key.size
+				<< " in " << item.collection << Qt::endl;
+			ok = false;
+			continue;
+		}
+
+		// Same defaults as the GUI: Tabler is stroke-based, the rest fill-based
+		IconModel model;
+		model.setIconList(list);
+		const bool fillBased = item.fillBasedStroke >= 0 ? item.fillBasedStroke != 0
+														 : !item.collection.startsWith("tabler");
+		model.setStrokeMode(fillBased);
+		model.setStrokeWidth(item.strokeWidth >= 0 ? item.strokeWidth : (fillBased ? 0 : 2));
+		model.setFillColor(item.fillColor);
+		model.setToneColor(item.toneColor);
+		model.setBackgroundColor(item.backgroundColor);
+		model.setGrayscale(item.grayscale);
+
+		std::vector<QRegularExpression> patterns;
+		for (const QString &pattern : item.patterns)
+			patterns.emplace_back(QRegularExpression::wildcardToRegularExpression(pattern),
+								  QRegularExpression::CaseInsensitiveOption);
+
+		const QList<int> sizes = item.sizes.isEmpty() ? QList<int>{ key.size } : item.sizes;
+		const QString styleName = key.bitmap ? QStringLiteral("Color") : iconStyleToString(item.style);
+		int matched = 0;
+
+		for (int index = 0; index < list->getCount(); ++index) {
+			const QString name = model.getIconName(index);
+			bool match = false;
+			for (const auto &pattern : patterns)
+				match = match || pattern.match(name).hasMatch();
+			if (!match)
+				continue;
+			++matched;
+
+			if (!item.entities.isEmpty()) {
+				EntityMap entities = model.currentEntities(index);
+				bool overridden = false;
+				for (auto it = item.entities.cbegin(); it != item.entities.cend(); ++it) {
+					if (entities.contains(it.key())) {
+						entities[it.key()] = it.value();
+						overridden = true;
+					}
+				}
+				if (overridden)
+					model.setIconEntities(index, entities);
+			}
+
+			QString fileName = item.fileName;
+			fileName.replace("{collection}", item.collection);
+			fileName.replace("{style}", styleName);
+			fileName.replace("{name}", safeFileName(name));
+			fileName.replace("{format}", item.format);
+
+			if (item.format == "svg") {
+				// Size independent; {size} is the list size
+				const QByteArray svg = model.getIconSvg(index).toUtf8();
+				write(QDir(m_manifest.outputDir).filePath(QString(fileName).replace("{size}", QString::number(key.size))),
+					  [svg](const QString &path) {
+						  QFile file(path);
+						  return file.open(QIODevice::WriteOnly) && file.write(svg) == svg.size();
+					  });
+				continue;
+			}
+
+			for (int size : sizes) {
+				const QString path = QDir(m_manifest.outputDir).filePath(QString(fileName).replace("{size}", QString::number(size)));
+				if (key.bitmap) {
+					// QPixmap work has to stay on this thread; only encoding is moved
+					const QImage image = model.getIconPixmapAtSize(index, size).toImage();
+					write(path, [image](const QString &path) { return !image.isNull() && image.save(path, "PNG"); });
+				} else {
+					const QByteArray source = model.getIconRenderSource(index);
+					const QColor background = item.backgroundColor;
+					write(path, [source, size, background](const QString &path) {
+						const QImage image = IconRenderer::renderSvg(source, size, background);
+						return !image.isNull() && image.save(path, "PNG");
+					});
+				}
+			}
+		}
+
+		if (matched == 0) {
+			err << "Export: no icons in " << item.collection << " match " << item.patterns.join(", ") << Qt::endl;
+			ok = false;
+		}
+		lists.trim();
+	}
+
+	pool.waitForDone();
+
+	m_stats.exported = exported;
+	m_stats.failed = failed;
+	m_stats.elapsedMs = timer.elapsed();
+	m_stats.threads = pool.maxThreadCount();
+	return ok && m_stats.failed == 0;
+}
+
+// ============================================================================
+// Command line
+// ============================================================================
+
+int runExportCommand(const QStringList &arguments) {
+	QTextStream out(stdout);
+	QTextStream err(stderr);
+
+	QCommandLineParser parser;
+	parser.setApplicationDescription("Exports icons listed in a JSON manifest without opening a window.");
+	parser.addHelpOption();
+	parser.addOption({ "export", "Manifest to export.", "manifest" });
+	parser.addOption({ "output", "Output directory, overrides the manifest's \"output\".", "dir" });
+	parser.addOption({ "jobs", "Render threads (default: all cores).", "n" });
+	parser.process(arguments);
+
+	IconExportManifest manifest;
+	QString error;
+	if (!IconExportManifest::load(parser.value("export"), &manifest, &error)) {
+		err << "Export: " << error << Qt::endl;
+		return 2;
+	}
+	if (parser.isSet("output"))
+		manifest.outputDir = parser.value("output");
+
+	registerBuiltinCollections();
+
+	IconBatchExporter exporter(manifest);
+	if (parser.isSet("jobs"))
+		exporter.setThreadCount(parser.value("jobs").toInt());
+	const bool ok = exporter.run();
+
+	const auto &stats = exporter.stats();
+	const double seconds = qMax<qint64>(1, stats.elapsedMs) / 1000.0;
+	out << "Exported " << stats.exported << " files";
+	if (stats.failed > 0)
+		out << " (" << stats.failed << " failed)";
+	out << " in " << stats.elapsedMs << " ms on " << stats.threads << " threads, "
+		<< qRound(stats.exported / seconds) << " files/s" << Qt::endl;
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,245 @@
+#ifndef ICONEXPORT_H
+#define ICONEXPORT_H
+
+#include <QColor>
+#include <QImage>
+#include <QMap>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "iconlistpool.h"
+#include "iconmodel.h"
+#include "pngstreamwriter.h"
+#include "spritesheet.h"
+#include "svgsprite.h"
+
+// Icon in the preview panel's export list
+//
+// Only the icon's identity and the render parameters at the time it was
+// added are kept; the image is rendered at export time at the requested
+// size and scale, so long lists hold no pixmaps.
+struct ExportIconInfo {
+	IconListKey list;    // Generated list of the icon
+	int index = -1;      // Index in that list
+	QString name;
+	QString style;       // Style combo text when added, e.g. "Outline" or, for bitmaps, "Color"/"Grayscale"
+	int size = 0;        // Output size at 1x unless the export overrides it
+	QColor fillColor = Qt::black;
+	QColor toneColor = QColor(200, 200, 200);
+	QColor backgroundColor = Qt::transparent;
+	int strokeWidth = 0;
+	bool fillBasedStroke = true;
+	bool grayscale = false;
+	EntityMap entities;  // Edited entity values, empty for the icon's own
+};
+
+// Export of the preview panel's list on a worker pool
+//
+// Sources are rebuilt on the GUI thread from each icon's list and parameters;
+// pool tasks render them at every selected scale (1x, 2x, 3x) and encode and
+// write the files. Scaled files get an "@2x"-style suffix. progress() and
+// finished() are delivered on the GUI thread; cancel() skips every task that
+// has not started yet.
+class IconExportJob : public QObject {
+	Q_OBJECT
+
+public:
+	explicit IconExportJob(QObject *parent = nullptr);
+	~IconExportJob() override;
+
+	// Device-pixel ratios PNGs are rendered at, {1} by default
+	void setScales(const QList<int> &scales);
+	QList<int> scales() const { return m_scales; }
+
+	// One file per icon in folder: PNG per scale, or the SVG text unless
+	// asPng. size overrides the icon's own size, 0 keeps it.
+	void exportFiles(const QList<ExportIconInfo> &icons, const QString &folder, bool asPng, int size = 0);
+
+	// All icons packed into one PNG sprite sheet per scale, see
+	// SpriteSheetLayout, with "<name>.json" (per scale) and "<name>.css"
+	// indexes next to it. size works as in exportFiles(). The sheet is
+	// rendered in bands of layout rows and streamed to the file, so memory
+	// stays bounded by a few bands whatever the sheet size.
+	void exportSpriteSheet(const QList<ExportIconInfo> &icons, const QString &filePath,
+						   int size = 0, int padding = 0);
+
+	// All SVG icons as <symbol>s of one SVG file, see SvgSpriteBuilder;
+	// bitmap icons are skipped
+	void exportSvgSprite(const QList<ExportIconInfo> &icons, const QString &filePath);
+
+	void cancel();
+	bool isRunning() const { return m_running; }
+
+	// Names of icons of the last export whose list no longer has them; they
+	// are counted as failed
+	const QStringList &unavailableIcons() const { return m_unavailable; }
+
+signals:
+	void progress(int done, int total);
+	void finished(int exported, int total, bool cancelled);
+
+private:
+	// Export data of one icon, safe to use on the pool
+	struct Icon {
+		QString fileName;
+		QByteArray source;         // SVG icons
+		QString svg;
+		QMap<int, QImage> images;  // Bitmap icons: source image per output size
+		QColor background;
+		int size = 0;              // Output size at 1x
+	};
+
+	// Sprite sheet in progress. Bands (layout rows) render on m_pool, at
+	// most SheetBandsInFlight at a time, and are encoded in order on
+	// m_encoder while later bands render.
+	struct SheetBand {
+		QImage image;     // RGBA8888, allocated when the band starts rendering
+		int pending = 0;  // Sprites still rendering into it
+	};
+
+	struct Sheet {
+		QString filePath;
+		std::vector<Icon> icons;
+		SpriteSheetLayout layout;
+		QStringList keys;
+		QList<int> scales;
+		QStringList imageFiles;  // Written sheets, one per finished scale
+		int scaleIndex = 0;
+		std::vector<SheetBand> bands;
+		int nextRender = 0;      // Next band to render
+		int nextEncode = 0;      // Next band to hand to the encoder
+		int encoded = 0;
+		int busy = 0;            // Tasks in flight on either pool
+		bool failed = false;
+		PngStreamWriter png;     // Driven by m_encoder once opened
+	};
+
+	// Icons are prepared on the GUI thread (lists, model, QPixmaps) in time
+	// slices between events, so large exports keep the window responsive
+	// and the pool starts on the first icons right away
+	struct Preparation {
+		QList<ExportIconInfo> icons;
+		int size = 0;
+		int next = 0;
+		// Consecutive icons of one list share it and the model; bitmap lists
+		// are pooled apart
+		IconListPool lists;
+		IconListPool bitmapLists;
+		IconModel model;
+		IconListKey modelList;  // List the model is on, empty if none
+		std::function<void(int index, Icon &&icon)> onIcon;  // In order
+		std::function<void()> onDone;  // Also runs when cancelled part way
+	};
+
+	void prepare(const QList<ExportIconInfo> &icons, int size,
+				 const std::function<void(int, Icon &&)> &onIcon, const std::function<void()> &onDone);
+	void prepareNext();
+	Icon prepareIcon(Preparation &preparation, const ExportIconInfo &info);
+	static QImage renderIcon(const Icon &icon, int size);
+	void start(int total);
+	void run(const std::function<bool()> &task);
+	void taskFinished(bool ok);
+	void skipTasks(int count);
+	void finish();
+
+	void startSheetScale();
+	void renderSheetBands();
+	void encodeSheetBands();
+	void sheetSpriteRendered(int band);
+	void sheetBandEncoded(int band, bool ok);
+	void sheetWritten(bool ok);
+	void finishSheet();
+
+	QThreadPool m_pool;
+	QThreadPool m_encoder;  // One thread: sheet bands are encoded in order
+	QList<int> m_scales { 1 };
+	std::atomic<bool> m_cancelled { false };
+	bool m_running = false;
+	int m_total = 0;
+	int m_done = 0;
+	int m_exported = 0;
+	QStringList m_unavailable;
+	std::function<void()> m_onAllDone;  // SVG sprite: builds the file
+	std::vector<SvgSpriteBuilder::Icon> m_symbols;  // SVG sprite: one slot per icon
+	std::unique_ptr<Sheet> m_sheet;
+	std::unique_ptr<Preparation> m_preparation;
+};
+
+// One manifest entry: icons of one list, exported with one set of options
+struct IconExportItem {
+	QString collection;
+	IconStyle style = IconStyle::Outline;  // Ignored for bitmap collections
+	int listSize = 0;                      // Generated list size, 0 = collection default
+	QStringList patterns;                  // Names or wildcards
+	QList<int> sizes;                      // Output sizes in pixels, empty = list size
+	QColor fillColor = Qt::black;
+	QColor toneColor = QColor(200, 200, 200);
+	QColor backgroundColor = Qt::transparent;
+	int strokeWidth = -1;                  // Slider position, -1 = GUI default
+	int fillBasedStroke = -1;              // 1 absolute, 0 relative, -1 = GUI default
+	EntityMap entities;                    // Overrides, applied to icons that define them
+	bool grayscale = false;                // Bitmap collections only
+	QString format = QStringLiteral("png");  // "png" or "svg"
+	QString fileName = QStringLiteral("{name}-{size}.{format}");
+};
+
+// Export manifest (JSON)
+//
+//   { "output": "icons",
+//     "items": [ { "collection": "tabler", "style": "Outline", "size": 24,
+//                  "icons": ["home", "arrow-*"], "sizes": [16, 32],
+//                  "fill": "#1e88e5", "tone": "#90caf9", "background": "transparent",
+//                  "stroke": 2, "strokeMode": "relative", "entities": { "color": "#f00" },
+//                  "grayscale": false, "format": "png",
+//                  "file": "{collection}/{name}-{size}.{format}" } ] }
+//
+// Only "collection" is required. "file" may use {collection}, {style}, {name},
+// {size} and {format}; relative paths are resolved against "output".
+struct IconExportManifest {
+	QString outputDir;
+	std::vector<IconExportItem> items;
+
+	static bool load(const QString &path, IconExportManifest *manifest, QString *error);
+};
+
+// Headless batch export of a manifest
+//
+// Every item is loaded into an IconModel, so sources are prepared with the
+// same rules as the GUI (colors, entities, stroke slider) and PNGs go
+// through IconRenderer::renderSvg() exactly like the preview export. Sources
+// are prepared on the calling thread; rendering, encoding and writing run on
+// a pool using every core.
+class IconBatchExporter {
+public:
+	struct Stats {
+		int exported = 0;
+		int failed = 0;
+		qint64 elapsedMs = 0;
+		int threads = 0;
+	};
+
+	explicit IconBatchExporter(const IconExportManifest &manifest);
+
+	void setThreadCount(int threads);
+
+	// False if any item could not be exported; errors are written to stderr
+	bool run();
+	const Stats &stats() const { return m_stats; }
+
+private:
+	IconExportManifest m_manifest;
+	int m_threads;
+	Stats m_stats;
+};
+
+// "Icons --export manifest.json [--output dir] [--jobs n]"; returns the exit code
+int runExportCommand(const QStringList &arguments);
+
+#endif // ICONEXPORT_H
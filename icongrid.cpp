@@ -1,4 +1,5 @@
 #include "icongrid.h"
+#include "globaliconlist.h"
 
 #include <QPainter>
 #include <QApplication>
@@ -34,14 +35,23 @@ void IconDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option,
 		painter->fillRect(option.rect, hoverColor);
 	}
 
-	// Get icon pixmap
-	QPixmap pixmap = index.data(Qt::DecorationRole).value<QPixmap>();
 	QString name = index.data(Qt::DisplayRole).toString();
 
 	// Calculate icon position (centered horizontally)
 	int iconX = option.rect.x() + (option.rect.width() - m_iconSize) / 2;
 	int iconY = option.rect.y() + m_padding;
 
+	// Atlas mode: blit the cell straight from the shared page
+	const QImage *atlasPage = nullptr;
+	QRect atlasRect;
+	auto *iconModel = qobject_cast<const IconModel*>(index.model());
+	QPixmap pixmap;
+	if (iconModel && iconModel->atlasSlot(index.row(), &atlasPage, &atlasRect)) {
+		painter->drawImage(QRect(iconX, iconY, m_iconSize, m_iconSize), *atlasPage, atlasRect);
+	} else {
+		pixmap = index.data(Qt::DecorationRole).value<QPixmap>();
+	}
+
 	// Draw the icon
 	if (!pixmap.isNull()) {
 		// Scale if needed
@@ -575,7 +585,8 @@ IconPreview::IconPreview(QWidget *parent)
 
 	// Export merged checkbox
 	m_exportMergedCheckbox = new QCheckBox(tr("Export merged"), m_exportWidget);
-	m_exportMergedCheckbox->setToolTip(tr("Merge all icons into a single PNG image"));
+	m_exportMergedCheckbox->setToolTip(tr("Pack all icons into one file: a PNG sprite sheet with a JSON and CSS index, "
+										  "or an SVG symbol sprite when \"Export as PNG\" is off"));
 
 	// Merged filename field
 	m_mergedFilenameEdit = new QLineEdit(m_exportWidget);
@@ -584,6 +595,39 @@ IconPreview::IconPreview(QWidget *parent)
 	m_mergedFilenameEdit->setPlaceholderText("icons_all.png");
 	m_mergedFilenameEdit->setEnabled(false);
 
+	// Space between sprites of a merged sheet
+	m_spritePaddingSpin = new QSpinBox(m_exportWidget);
+	m_spritePaddingSpin->setAttribute(Qt::WA_MacSmallSize);
+	m_spritePaddingSpin->setRange(0, 64);
+	m_spritePaddingSpin->setValue(2);
+	m_spritePaddingSpin->setPrefix(tr("Padding "));
+	m_spritePaddingSpin->setSuffix(" px");
+	m_spritePaddingSpin->setToolTip(tr("Space between icons on the sprite sheet"));
+	m_spritePaddingSpin->setEnabled(false);
+	auto *mergedLayout = new QHBoxLayout();
+	mergedLayout->setSpacing(4);
+	mergedLayout->addWidget(m_mergedFilenameEdit, 1);
+	mergedLayout->addWidget(m_spritePaddingSpin);
+
+	// PNG size and scales; icons are rendered at export time
+	auto *exportSizeLayout = new QHBoxLayout();
+	exportSizeLayout->setSpacing(4);
+	m_exportSizeSpin = new QSpinBox(m_exportWidget);
+	m_exportSizeSpin->setAttribute(Qt::WA_MacSmallSize);
+	m_exportSizeSpin->setRange(0, 1024);
+	m_exportSizeSpin->setSuffix(" px");
+	m_exportSizeSpin->setSpecialValueText(tr("Icon size"));
+	m_exportSizeSpin->setToolTip(tr("PNG size at 1x; icons keep their own size unless set"));
+	exportSizeLayout->addWidget(m_exportSizeSpin, 1);
+	for (int scale = 1; scale <= 3; ++scale) {
+		auto *checkbox = new QCheckBox(QString("%1x").arg(scale), m_exportWidget);
+		checkbox->setChecked(scale == 1);
+		checkbox->setToolTip(scale == 1 ? tr("Export PNGs at their size")
+										: tr("Export PNGs at %1x their size, as name@%1x.png").arg(scale));
+		exportSizeLayout->addWidget(checkbox);
+		m_scaleCheckboxes.append(checkbox);
+	}
+
 	m_exportListWidget = new QListWidget(m_exportWidget);
 
 	// Bottom buttons
@@ -599,8 +643,19 @@ IconPreview::IconPreview(QWidget *parent)
 
 	exportLayout->addWidget(m_exportAsPngCheckbox);
 	exportLayout->addWidget(m_exportMergedCheckbox);
-	exportLayout->addWidget(m_mergedFilenameEdit);
+	exportLayout->addLayout(mergedLayout);
+	exportLayout->addLayout(exportSizeLayout);
+	// Progress of a running export; "Export..." turns into "Cancel" meanwhile
+	m_exportProgress = new QProgressBar(m_exportWidget);
+	m_exportProgress->setAttribute(Qt::WA_MacSmallSize);
+	m_exportProgress->setTextVisible(false);
+	m_exportProgress->setVisible(false);
+	m_exportJob = new IconExportJob(this);
+	connect(m_exportJob, &IconExportJob::progress, this, &IconPreview::onExportProgress);
+	connect(m_exportJob, &IconExportJob::finished, this, &IconPreview::onExportFinished);
+
 	exportLayout->addWidget(m_exportListWidget, 1);
+	exportLayout->addWidget(m_exportProgress);
 	exportLayout->addLayout(exportButtonLayout);
 
 	// Connect checkbox interaction
@@ -688,15 +743,9 @@ void IconPreview::onButtonClicked(int index) {
 			}
 			break;
 		case 3: // Add to Export
-			if (!m_currentName.isEmpty()) {
-				ExportIconInfo info;
-				info.name = m_currentName;
-				info.pixmap = m_currentPixmap;
-				info.svg = m_currentSvg;
-				info.style = m_currentStyle;
-				info.size = m_currentSize;
-				addToExportList(info);
-			}
+			// The grid fills in the render source, see IconGrid::addCurrentToExportList()
+			if (!m_currentName.isEmpty())
+				emit addToExportRequested();
 			break;
 		case 4: // Clear export list
 			clearExportList();
@@ -740,7 +789,7 @@ void IconPreview::setIcon(const QPixmap &pixmap, const QString &name, const QStr
 	m_exportButton->setEnabled(!name.isEmpty() || !m_exportList.isEmpty());
 }
 
-void IconPreview::addToExportList(const ExportIconInfo &info) {
+void IconPreview::addToExportList(const ExportIconInfo &info, const QPixmap &thumbnail) {
 	// Check if already in list by name
 	for (const auto &existing : m_exportList) {
 		if (existing.name == info.name && existing.style == info.style && existing.size == info.size)
@@ -752,8 +801,8 @@ void IconPreview::addToExportList(const ExportIconInfo &info) {
 	QListWidgetItem *item = new QListWidgetItem(m_exportListWidget);
 	QString displayText = QString("%1 (%2, %3)").arg(info.name).arg(info.style).arg(info.size);
 	item->setText(displayText);
-	if (!info.pixmap.isNull()) {
-		item->setIcon(QIcon(info.pixmap.scaled(16, 16, Qt::KeepAspectRatio, Qt::SmoothTransformation)));
+	if (!thumbnail.isNull()) {
+		item->setIcon(QIcon(thumbnail.scaled(16, 16, Qt::KeepAspectRatio, Qt::SmoothTransformation)));
 	}
 
 	m_exportButton->setEnabled(true);
@@ -903,20 +952,17 @@ void IconPreview::onEntityValueChanged(int row, int column) {
 }
 
 void IconPreview::onExportMergedChanged(bool checked) {
-	// When "Export merged" is checked, save state, auto-check and disable "Export as PNG"
-	if (checked) {
-		m_exportAsPngSaved = m_exportAsPngCheckbox->isChecked();
-		m_exportAsPngCheckbox->setChecked(true);
-		m_exportAsPngCheckbox->setEnabled(false);
-		m_mergedFilenameEdit->setEnabled(true);
-	} else {
-		m_exportAsPngCheckbox->setEnabled(true);
-		m_exportAsPngCheckbox->setChecked(m_exportAsPngSaved);
-		m_mergedFilenameEdit->setEnabled(false);
-	}
+	// Merged with "Export as PNG" is a sprite sheet, without it an SVG sprite
+	m_mergedFilenameEdit->setEnabled(checked);
+	m_spritePaddingSpin->setEnabled(checked);
 }
 
 void IconPreview::onDoExport() {
+	if (m_exportJob->isRunning()) {
+		m_exportJob->cancel();
+		return;
+	}
+
 	if (m_exportList.isEmpty()) {
 		QMessageBox::information(this, tr("Export"), tr("No icons in export list."));
 		return;
@@ -924,83 +970,97 @@ void IconPreview::onDoExport() {
 
 	bool exportAsPng = m_exportAsPngCheckbox->isChecked();
 	bool exportMerged = m_exportMergedCheckbox->isChecked();
+	int exportSize = m_exportSizeSpin->value();
+	QList<int> scales;
+	for (int i = 0; i < m_scaleCheckboxes.size(); ++i) {
+		if (m_scaleCheckboxes[i]->isChecked())
+			scales.append(i + 1);
+	}
+	m_exportJob->setScales(scales);  // None checked exports 1x
+	QString defaultPath = m_lastExportPath.isEmpty() ? QDir::homePath() : m_lastExportPath;
 
 	if (exportMerged) {
 		// Export merged: ask for save file location
 		QString filename = m_mergedFilenameEdit->text().trimmed();
 		if (filename.isEmpty())
-			filename = "icons_all.png";
-		if (!filename.endsWith(".png", Qt::CaseInsensitive))
-			filename += ".png";
+			filename = "icons_all";
+		if (filename.endsWith(".png", Qt::CaseInsensitive) || filename.endsWith(".svg", Qt::CaseInsensitive))
+			filename.chop(4);
+		filename += exportAsPng ? ".png" : ".svg";
 
-		QString defaultPath = m_lastExportPath.isEmpty() ? QDir::homePath() : m_lastExportPath;
 		QString filePath = QFileDialog::getSaveFileName(this, tr("Save Merged Icons"),
-			defaultPath + "/" + filename, tr("PNG Images (*.png)"));
+			defaultPath + "/" + filename, exportAsPng ? tr("PNG Images (*.png)") : tr("SVG Images (*.svg)"));
 		if (filePath.isEmpty())
 			return;
 		m_lastExportPath = QFileInfo(filePath).absolutePath();
+		m_exportTarget = filePath;
+		m_exportingMerged = true;
+		m_exportingSvgSprite = !exportAsPng;
 
-		// Calculate merged image dimensions (icons in a row)
-		int iconCount = m_exportList.size();
-		int iconSize = 64;  // Use a fixed size for merged export
-		int cols = qMin(iconCount, 16);  // Max 16 icons per row
-		int rows = (iconCount + cols - 1) / cols;
-
-		QImage mergedImage(cols * iconSize, rows * iconSize, QImage::Format_ARGB32);
-		mergedImage.fill(Qt::transparent);
-
-		QPainter painter(&mergedImage);
-		for (int i = 0; i < iconCount; ++i) {
-			int x = (i % cols) * iconSize;
-			int y = (i / cols) * iconSize;
-			QPixmap scaledPixmap = m_exportList[i].pixmap.scaled(iconSize, iconSize,
-				Qt::KeepAspectRatio, Qt::SmoothTransformation);
-			int offsetX = (iconSize - scaledPixmap.width()) / 2;
-			int offsetY = (iconSize - scaledPixmap.height()) / 2;
-			painter.drawPixmap(x + offsetX, y + offsetY, scaledPixmap);
-		}
-		painter.end();
-
-		if (mergedImage.save(filePath)) {
-			QMessageBox::information(this, tr("Export"),
-				tr("Merged %1 icons to:\n%2").arg(iconCount).arg(filePath));
+		if (exportAsPng) {
+			// Mixed sizes are packed; the JSON and CSS index are written alongside
+			m_exportJob->exportSpriteSheet(m_exportList, filePath, exportSize, m_spritePaddingSpin->value());
 		} else {
-			QMessageBox::warning(this, tr("Export Error"),
-				tr("Failed to save merged image."));
+			m_exportJob->exportSvgSprite(m_exportList, filePath);
 		}
 	} else {
 		// Export individual icons: ask for folder
-		QString defaultPath = m_lastExportPath.isEmpty() ? QDir::homePath() : m_lastExportPath;
 		QString folder = QFileDialog::getExistingDirectory(this, tr("Select Export Folder"), defaultPath);
 		if (folder.isEmpty())
 			return;
 		m_lastExportPath = folder;
+		m_exportTarget = folder;
+		m_exportingMerged = false;
+		m_exportingSvgSprite = false;
 
-		int exported = 0;
-		for (const auto &info : m_exportList) {
-			QString filename = info.name;
-			// Sanitize filename
-			filename.replace(QRegularExpression("[/\\\\:*?\"<>|]"), "_");
-
-			if (exportAsPng || info.svg.isEmpty()) {
-				// Export as PNG
-				QString filePath = folder + "/" + filename + ".png";
-				if (info.pixmap.save(filePath))
-					++exported;
-			} else {
-				// Export as SVG
-				QString filePath = folder + "/" + filename + ".svg";
-				QFile file(filePath);
-				if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-					file.write(info.svg.toUtf8());
-					file.close();
-					++exported;
-				}
-			}
-		}
+		m_exportJob->exportFiles(m_exportList, folder, exportAsPng, exportSize);
+	}
+
+	m_doExportButton->setText(" " + tr("Cancel") + " ");
+	m_doExportButton->setToolTip(tr("Cancel the running export"));
+	m_exportProgress->setVisible(true);
+}
+
+void IconPreview::onExportProgress(int done, int total) {
+	m_exportProgress->setMaximum(qMax(1, total));
+	m_exportProgress->setValue(done);
+}
 
+void IconPreview::onExportFinished(int exported, int total, bool cancelled) {
+	m_doExportButton->setText(" " + tr("Export...") + " ");
+	m_doExportButton->setToolTip(tr("Export icons to folder"));
+	m_exportProgress->setVisible(false);
+
+	// Icons whose list has changed since they were added are skipped
+	QString unavailable;
+	const QStringList &missing = m_exportJob->unavailableIcons();
+	if (!cancelled && !missing.isEmpty()) {
+		unavailable = "\n\n" + tr("No longer available (%1): %2").arg(missing.size())
+			.arg(missing.mid(0, 10).join(", ") + (missing.size() > 10 ? ", ..." : ""));
+	}
+
+	if (cancelled) {
+		QMessageBox::information(this, tr("Export"),
+			tr("Export cancelled after %1 of %2 icons.").arg(exported).arg(total));
+	} else if (m_exportingSvgSprite) {
+		if (exported > 0) {
+			QMessageBox::information(this, tr("Export"),
+				tr("Wrote %1 of %2 icons as SVG symbols to:\n%3").arg(exported).arg(total).arg(m_exportTarget) + unavailable);
+		} else {
+			QMessageBox::warning(this, tr("Export Error"),
+				tr("Failed to save the SVG sprite.") + unavailable);
+		}
+	} else if (m_exportingMerged) {
+		if (exported > 0) {
+			QMessageBox::information(this, tr("Export"),
+				tr("Packed %1 icons into:\n%2\nwith a JSON and CSS index").arg(exported).arg(m_exportTarget) + unavailable);
+		} else {
+			QMessageBox::warning(this, tr("Export Error"),
+				tr("Failed to save the sprite sheet.") + unavailable);
+		}
+	} else {
 		QMessageBox::information(this, tr("Export"),
-			tr("Exported %1 of %2 icons to:\n%3").arg(exported).arg(m_exportList.size()).arg(folder));
+			tr("Exported %1 of %2 icons to:\n%3").arg(exported).arg(total).arg(m_exportTarget) + unavailable);
 	}
 }
 
@@ -1040,6 +1100,8 @@ IconGrid::IconGrid(QWidget *parent)
 	m_model = new IconModel(this);
 	m_delegate = new IconDelegate(this);
 
+	m_model->setAtlasEnabled(true);
+
 	m_listView->setModel(m_model);
 	m_listView->setItemDelegate(m_delegate);
 
@@ -1062,7 +1124,18 @@ IconGrid::IconGrid(QWidget *parent)
 	m_listView->setContextMenuPolicy(Qt::CustomContextMenu);
 
 	// Connections
-	connect(m_searchBar, &SearchBar::textChanged, this, &IconGrid::setFilter);
+	connect(m_searchBar, &SearchBar::textChanged, this, [this](const QString &text) {
+		m_pendingFilter = text;
+		if (text.isEmpty())
+			applyPendingFilter();  // Clearing the search is instant
+		else
+			m_filterTimer.start();
+	});
+
+	// Search input is applied once typing pauses
+	m_filterTimer.setSingleShot(true);
+	m_filterTimer.setInterval(150);
+	connect(&m_filterTimer, &QTimer::timeout, this, &IconGrid::applyPendingFilter);
 
 	connect(m_toolBar, &IconToolBar::fillColorChanged, this, &IconGrid::setFillColor);
 	connect(m_toolBar, &IconToolBar::toneColorChanged, this, &IconGrid::setToneColor);
@@ -1075,6 +1148,20 @@ IconGrid::IconGrid(QWidget *parent)
 	connect(m_listView, &QListView::doubleClicked, this, &IconGrid::onDoubleClicked);
 	connect(m_listView, &QListView::customContextMenuRequested, this, &IconGrid::onContextMenu);
 
+	// Render scheduling follows the visible rows
+	m_viewportTimer.setSingleShot(true);
+	m_viewportTimer.setInterval(30);
+	connect(&m_viewportTimer, &QTimer::timeout, this, &IconGrid::updateRenderViewport);
+	connect(m_listView->verticalScrollBar(), &QScrollBar::valueChanged,
+			this, &IconGrid::scheduleViewportUpdate);
+	connect(m_model, &QAbstractItemModel::modelReset, this, &IconGrid::scheduleViewportUpdate);
+	connect(m_model, &QAbstractItemModel::rowsInserted, this, &IconGrid::scheduleViewportUpdate);
+	connect(m_model, &QAbstractItemModel::rowsRemoved, this, &IconGrid::scheduleViewportUpdate);
+	connect(m_model, &QAbstractItemModel::layoutChanged, this, &IconGrid::scheduleViewportUpdate);
+	m_listView->viewport()->installEventFilter(this);
+
+	connect(m_preview, &IconPreview::addToExportRequested, this, &IconGrid::addCurrentToExportList);
+
 	// Entity editing
 	connect(m_preview, &IconPreview::entitiesChanged, this, [this](const EntityMap &entities) {
 		QModelIndex current = m_listView->currentIndex();
@@ -1097,7 +1184,61 @@ IconGrid::IconGrid(QWidget *parent)
 
 IconGrid::~IconGrid() = default;
 
-void IconGrid::setIconList(IconList *list) {
+bool IconGrid::eventFilter(QObject *watched, QEvent *event) {
+	if (watched == m_listView->viewport() && event->type() == QEvent::Resize)
+		scheduleViewportUpdate();
+	return QWidget::eventFilter(watched, event);
+}
+
+void IconGrid::scheduleViewportUpdate() {
+	if (!m_viewportTimer.isActive())
+		m_viewportTimer.start();
+}
+
+// Probe the view row by row for the first (step > 0) or last (step < 0) visible item.
+// Items are laid out on a uniform grid, so a handful of indexAt() calls is enough.
+static int visibleEdgeRow(QListView *view, int step) {
+	const QRect area = view->viewport()->rect();
+	if (area.isEmpty())
+		return -1;
+	const int stepY = qMax(1, qAbs(step));
+	const int stepX = stepY;
+	if (step > 0) {
+		for (int y = area.top(); y <= area.bottom(); y += stepY)
+			for (int x = area.left(); x <= area.right(); x += stepX) {
+				QModelIndex index = view->indexAt(QPoint(x, y));
+				if (index.isValid())
+					return index.row();
+			}
+	} else {
+		for (int y = area.bottom(); y >= area.top(); y -= stepY)
+			for (int x = area.right(); x >= area.left(); x -= stepX) {
+				QModelIndex index = view->indexAt(QPoint(x, y));
+				if (index.isValid())
+					return index.row();
+			}
+	}
+	return -1;
+}
+
+void IconGrid::updateRenderViewport() {
+	if (m_model->rowCount() == 0) {
+		m_model->setViewport(-1, -1);
+		return;
+	}
+	// Half a cell, so the probe cannot step over an item
+	const int step = qMax(4, (m_delegate->iconSize() + 16) / 2);
+	int first = visibleEdgeRow(m_listView, step);
+	int last = visibleEdgeRow(m_listView, -step);
+	if (first < 0 || last < first) {
+		m_model->setViewport(-1, -1);
+		return;
+	}
+	m_model->setViewport(first, last);
+}
+
+void IconGrid::setIconList(IconList *list, const IconListKey &key) {
+	m_listKey = key;
 	// Block signals to prevent auto-selection during model update
 	m_listView->blockSignals(true);
 	m_listView->selectionModel()->blockSignals(true);
@@ -1135,9 +1276,16 @@ int IconGrid::iconSize() const {
 }
 
 void IconGrid::setFilter(const QString &filter) {
+	m_filterTimer.stop();
+	m_pendingFilter = filter;
 	m_model->setFilter(filter);
 }
 
+void IconGrid::applyPendingFilter() {
+	m_filterTimer.stop();
+	m_model->setFilter(m_pendingFilter);
+}
+
 void IconGrid::setFillColor(const QColor &color) {
 	m_model->setFillColor(color);
 }
@@ -1217,15 +1365,32 @@ void IconGrid::addCurrentToExportList() {
 	if (!current.isValid())
 		return;
 
+	int actualIndex = current.data(IconIndexRole).toInt();
+
 	ExportIconInfo info;
-	info.name = current.data(IconNameRole).toString();
-	info.svg = current.data(IconSvgRole).toString();
+	if (auto *global = dynamic_cast<GlobalIconList*>(m_model->iconList())) {
+		info.list = global->listKey(actualIndex);
+		info.index = global->localIndex(actualIndex);
+	} else {
+		info.list = m_listKey;
+		info.index = actualIndex;
+	}
+	if (info.list.collectionId.isEmpty())
+		return;
 
-	int actualIndex = current.data(IconIndexRole).toInt();
-	info.pixmap = m_model->getIconPixmap(actualIndex);
+	info.name = current.data(IconNameRole).toString();
 	info.style = m_toolBar->currentStyle();
 	info.size = m_model->iconSize();
-
-	m_preview->addToExportList(info);
+	info.fillColor = m_model->fillColor();
+	info.toneColor = m_model->toneColor();
+	info.backgroundColor = m_model->backgroundColor();
+	info.strokeWidth = m_model->strokeWidth();
+	info.fillBasedStroke = m_model->isFillBasedStroke();
+	info.grayscale = m_model->isGrayscale();
+	if (m_model->iconHasEntities(actualIndex))
+		info.entities = m_model->currentEntities(actualIndex);
+
+	// The list only shows the cached thumbnail; the export renders its own
+	m_preview->addToExportList(info, m_model->getIconPixmap(actualIndex));
 }
 
@@ -19,19 +19,14 @@
 #include <QColorDialog>
 #include <QSlider>
 #include <QMenu>
+#include <QTimer>
+#include <QProgressBar>
+#include <QSpinBox>
 
 #include "iconmodel.h"
+#include "iconexport.h"
 #include "extrawidgets.h"
 
-// Info for icon export
-struct ExportIconInfo {
-	QString name;
-	QPixmap pixmap;
-	QString svg;
-	QString style;
-	int size;
-};
-
 // Custom delegate for rendering icons in the grid
 class IconDelegate : public QStyledItemDelegate {
 	Q_OBJECT
@@ -173,7 +168,7 @@ public:
 				 const QStringList &tags = QStringList(), const QString &category = QString());
 	void clear();
 
-	void addToExportList(const ExportIconInfo &info);
+	void addToExportList(const ExportIconInfo &info, const QPixmap &thumbnail);
 	void clearExportList();
 	QList<ExportIconInfo> exportList() const;
 
@@ -188,6 +183,7 @@ signals:
 	void copySvgRequested();
 	void copyPngRequested();
 	void exportRequested(bool merge);
+	void addToExportRequested();  // "Add to Export" for the current icon
 	void entitiesChanged(const EntityMap &entities);
 
 private slots:
@@ -195,6 +191,8 @@ private slots:
 	void onEntityValueChanged(int row, int column);
 	void onExportMergedChanged(bool checked);
 	void onDoExport();
+	void onExportProgress(int done, int total);
+	void onExportFinished(int exported, int total, bool cancelled);
 
 private:
 	void updateEntitiesTable();
@@ -224,8 +222,15 @@ private:
 	QCheckBox *m_exportAsPngCheckbox;
 	QCheckBox *m_exportMergedCheckbox;
 	QLineEdit *m_mergedFilenameEdit;
-	bool m_exportAsPngSaved = false;  // Saved state when merged is checked
+	QSpinBox *m_spritePaddingSpin;
+	QSpinBox *m_exportSizeSpin;             // PNG size at 1x, 0 = icon size
+	QList<QCheckBox*> m_scaleCheckboxes;    // 1x, 2x, 3x
 	QString m_lastExportPath;  // Last used export folder path
+	QString m_exportTarget;    // Folder or merged file of the running export
+	bool m_exportingMerged = false;
+	bool m_exportingSvgSprite = false;
+	QProgressBar *m_exportProgress;
+	IconExportJob *m_exportJob;
 
 	// View switcher (Export/Entities buttons + stacked widget)
 	QWidget *m_viewSwitcher;
@@ -245,7 +250,8 @@ public:
 	explicit IconGrid(QWidget *parent = nullptr);
 	~IconGrid() override;
 
-	void setIconList(IconList *list);
+	// key identifies the list for the export list; global search passes none
+	void setIconList(IconList *list, const IconListKey &key = IconListKey());
 	IconModel *model() const;
 	IconPreview *preview() const;
 	IconToolBar *toolBar() const;
@@ -269,9 +275,15 @@ private slots:
 	void onDoubleClicked(const QModelIndex &index);
 	void onContextMenu(const QPoint &pos);
 	void onAddToExport();
+	void updateRenderViewport();
+	void applyPendingFilter();
+
+protected:
+	bool eventFilter(QObject *watched, QEvent *event) override;
 
 private:
 	void addCurrentToExportList();
+	void scheduleViewportUpdate();
 
 	QListView *m_listView;
 	IconModel *m_model;
@@ -281,6 +293,10 @@ private:
 	IconPreview *m_preview;
 	QMenu *m_contextMenu;
 	QAction *m_addToExportAction;
+	QTimer m_viewportTimer;  // Throttles viewport reports while scrolling
+	QTimer m_filterTimer;    // Coalesces search keystrokes
+	QString m_pendingFilter;
+	IconListKey m_listKey;   // List shown, see setIconList()
 };
 
 #endif // ICONGRID_H
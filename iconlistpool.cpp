@@ -0,0 +1,42 @@
+#include "iconlistpool.h"
+
+IconListPool::IconListPool(int capacity)
+	: m_capacity(qMax(1, capacity))
+{
+}
+
+IconList *IconListPool::acquire(const IconListKey &key) {
+	auto found = m_index.find(key);
+	if (found != m_index.end()) {
+		m_lists.splice(m_lists.begin(), m_lists, found.value());
+		return m_lists.front().second.get();
+	}
+
+	auto &registry = IconCollectionRegistry::instance();
+	IconList *list = key.bitmap
+		? static_cast<IconList*>(registry.createBitmapList(key.collectionId, key.size))
+		: static_cast<IconList*>(registry.createIconList(key.collectionId, key.style, key.size));
+	if (!list)
+		return nullptr;
+
+	m_lists.emplace_front(key, std::unique_ptr<IconList>(list));
+	m_index.insert(key, m_lists.begin());
+	return list;
+}
+
+void IconListPool::trim() {
+	while (static_cast<int>(m_lists.size()) > m_capacity) {
+		m_index.remove(m_lists.back().first);
+		m_lists.pop_back();
+	}
+}
+
+void IconListPool::clear() {
+	m_index.clear();
+	m_lists.clear();
+}
+
+void IconListPool::setCapacity(int capacity) {
+	m_capacity = qMax(1, capacity);
+	trim();
+}
@@ -0,0 +1,64 @@
+#ifndef ICONLISTPOOL_H
+#define ICONLISTPOOL_H
+
+#include <QHash>
+#include <QString>
+
+#include <list>
+#include <memory>
+
+#include "iconmodel.h"
+
+// Identifies one generated list: collection, style and icon size
+struct IconListKey {
+	QString collectionId;
+	IconStyle style = IconStyle::Outline;  // Ignored for bitmap collections
+	int size = 0;
+	bool bitmap = false;
+
+	bool operator==(const IconListKey &other) const {
+		return size == other.size && bitmap == other.bitmap
+			&& (bitmap || style == other.style)
+			&& collectionId == other.collectionId;
+	}
+	bool operator!=(const IconListKey &other) const { return !(*this == other); }
+};
+
+inline size_t qHash(const IconListKey &key, size_t seed = 0) {
+	return qHashMulti(seed, key.collectionId, key.bitmap ? -1 : static_cast<int>(key.style),
+					  key.size, key.bitmap);
+}
+
+// Owns the icon lists created through the registry
+//
+// Switching collection, style or size reuses the list for that key if it is
+// still pooled, so flipping back is instant. Only the most recent lists are
+// kept; the rest are deleted by trim() once the model has moved on, which
+// keeps memory flat over long sessions. GUI thread only.
+class IconListPool {
+public:
+	explicit IconListPool(int capacity = 4);
+
+	// Returns the pooled list or creates it; nullptr if the registry has none.
+	// The returned list becomes the most recently used one.
+	IconList *acquire(const IconListKey &key);
+
+	// Deletes least recently used lists beyond the capacity. The most recent
+	// list is never deleted; call this after the model switched to it.
+	void trim();
+	void clear();
+
+	void setCapacity(int capacity);
+	int capacity() const { return m_capacity; }
+	int count() const { return static_cast<int>(m_lists.size()); }
+
+private:
+	using Entry = std::pair<IconListKey, std::unique_ptr<IconList>>;
+	using LruList = std::list<Entry>;  // Most recently used at the front
+
+	LruList m_lists;
+	QHash<IconListKey, LruList::iterator> m_index;
+	int m_capacity;
+};
+
+#endif // ICONLISTPOOL_H
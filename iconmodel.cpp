@@ -1,52 +1,18 @@
 #include "iconmodel.h"
+#include "globaliconlist.h"
 
 #include <QDebug>
 #include <QSvgRenderer>
 #include <QPainter>
-#include <QRegularExpression>
-
-// Helper to adjust stroke-width in SVG source
-// For fill-based icons: sliderPos maps to absolute values 0, 0.25, 0.5, 1, 1.25, 1.5
-// For stroke-based icons: sliderPos maps to relative scales 0.5x, 0.75x, 1x, 1.25x, 1.5x
-static QString adjustStrokeWidth(const QString &svgSource, int sliderPos, bool fillBased) {
-	static QRegularExpression rx(QStringLiteral("stroke-width=\"([0-9.]+)\""));
-
-	if (fillBased) {
-		// Fill-based: replace stroke-width with absolute value
-		static const double absValues[] = { 0.0, 0.25, 0.5, 1.0, 1.25, 1.5 };
-		double newWidth = absValues[qBound(0, sliderPos, 5)];
-		QString result = svgSource;
-		result.replace(rx, QString("stroke-width=\"%1\"").arg(newWidth));
-		return result;
-	} else {
-		// Stroke-based: scale existing stroke-width values
-		if (sliderPos == 2)  // 1x scale, no change needed
-			return svgSource;
-
-		static const double scales[] = { 0.5, 0.75, 1.0, 1.25, 1.5 };
-		double scale = scales[qBound(0, sliderPos, 4)];
-
-		QString result = svgSource;
-		QRegularExpressionMatchIterator it = rx.globalMatch(svgSource);
-
-		// Process matches in reverse order to preserve positions
-		QList<QRegularExpressionMatch> matches;
-		while (it.hasNext())
-			matches.prepend(it.next());
-
-		for (const auto &match : matches) {
-			bool ok;
-			double width = match.captured(1).toDouble(&ok);
-			if (ok) {
-				double newWidth = width * scale;
-				if (newWidth < 0.25) newWidth = 0.25;  // Minimum stroke width
-				QString replacement = QString("stroke-width=\"%1\"").arg(newWidth);
-				result.replace(match.capturedStart(), match.capturedLength(), replacement);
-			}
-		}
-		return result;
-	}
-}
+
+#include <algorithm>
+#include <cstring>
+
+// Above this many removed/inserted runs a filter change is applied as one relayout
+static const int c_maxFilterRuns = 32;
+
+// Cell sizes whose atlas is kept after switching away
+static const size_t c_maxAtlases = 3;
 
 // ============================================================================
 // IconModel
@@ -54,8 +20,10 @@ static QString adjustStrokeWidth(const QString &svgSource, int sliderPos, bool f
 
 IconModel::IconModel(QObject *parent)
 	: QAbstractListModel(parent)
-	, m_pixmapCache(500) // Cache up to 500 rendered icons
+	, m_renderer(new IconRenderer(this))
+	, m_templates(32 * 1024 * 1024)
 {
+	connect(m_renderer, &IconRenderer::iconsRendered, this, &IconModel::onIconsRendered);
 }
 
 IconModel::~IconModel() = default;
@@ -79,7 +47,7 @@ QVariant IconModel::data(const QModelIndex &index, int role) const {
 			return entry.name;
 
 		case Qt::DecorationRole:
-			return renderIcon(actualIndex);
+			return iconDecoration(actualIndex);
 
 		case IconSvgRole:
 			return getIconSvg(actualIndex);
@@ -111,9 +79,14 @@ void IconModel::setIconList(IconList *list) {
 	beginResetModel();
 
 	m_iconList = list;
+	m_globalList = dynamic_cast<GlobalIconList*>(list);
+	m_compiledSource = dynamic_cast<const CompiledPathSource*>(list);
+	m_libraryName = m_iconList ? m_iconList->getLibraryName() : QString();
 	m_allIcons.clear();
 	m_filteredIndices.clear();
-	m_pixmapCache.clear();
+	m_templates.clear();
+	m_searchIndex.clear();  // Rebuilt on the first search
+	invalidateRenders();
 
 	if (m_iconList) {
 		// Apply current colors to the new list
@@ -123,6 +96,10 @@ void IconModel::setIconList(IconList *list) {
 		if (auto *twoTone = dynamic_cast<SVGTwoToneIconList*>(m_iconList)) {
 			twoTone->setToneColor(m_toneColor);
 		}
+		// Pooled lists may carry state from an earlier use
+		if (auto *bitmap = dynamic_cast<BitmapIconList*>(m_iconList)) {
+			bitmap->setGrayscale(m_grayscale);
+		}
 
 		int count = m_iconList->getCount();
 		m_allIcons.reserve(count);
@@ -134,10 +111,10 @@ void IconModel::setIconList(IconList *list) {
 			entry.name = m_iconList->getName(i);
 			entry.index = i;
 			entry.libraryName = libraryName;
-			m_allIcons.push_back(entry);
+			m_allIcons.push_back(std::move(entry));
 		}
 
-		rebuildFilteredList();
+		m_filteredIndices = matchingIndices();
 	}
 
 	endResetModel();
@@ -164,10 +141,30 @@ bool IconModel::isBitmapMode() const {
 	return m_iconList && m_iconList->isBitmap();
 }
 
+bool IconModel::isBitmapIcon(int index) const {
+	if (isBitmapMode())
+		return true;
+	return m_globalList && index >= 0 && index < static_cast<int>(m_allIcons.size())
+		&& m_globalList->isBitmap(m_allIcons[index].index);
+}
+
+BitmapIconList *IconModel::bitmapSource(int index, int *bitmapIndex) const {
+	if (index < 0 || index >= static_cast<int>(m_allIcons.size()))
+		return nullptr;
+	if (auto *bitmap = bitmapIconList()) {
+		*bitmapIndex = m_allIcons[index].index;
+		return bitmap;
+	}
+	// "All Libraries": drawn from the collection's own list like in bitmap mode
+	return m_globalList ? m_globalList->bitmapList(m_allIcons[index].index, bitmapIndex) : nullptr;
+}
+
 void IconModel::setIconSize(int size) {
 	if (m_iconSize != size) {
 		m_iconSize = size;
-		m_pixmapCache.clear();
+		if (m_atlasEnabled)
+			useAtlas(size);
+		invalidateRenders();
 		emit dataChanged(index(0), index(rowCount() - 1), {Qt::DecorationRole});
 	}
 }
@@ -182,7 +179,7 @@ void IconModel::setFillColor(const QColor &color) {
 		if (auto *svg = svgIconList()) {
 			svg->setFillColor(color);
 		}
-		m_pixmapCache.clear();
+		invalidateRenders();
 		emit dataChanged(index(0), index(rowCount() - 1), {Qt::DecorationRole});
 	}
 }
@@ -197,7 +194,7 @@ void IconModel::setToneColor(const QColor &color) {
 		if (auto *twoTone = dynamic_cast<SVGTwoToneIconList*>(m_iconList)) {
 			twoTone->setToneColor(color);
 		}
-		m_pixmapCache.clear();
+		invalidateRenders();
 		emit dataChanged(index(0), index(rowCount() - 1), {Qt::DecorationRole});
 	}
 }
@@ -216,7 +213,7 @@ void IconModel::setGrayscale(bool enabled) {
 		if (auto *bitmap = bitmapIconList()) {
 			bitmap->setGrayscale(enabled);
 		}
-		m_pixmapCache.clear();
+		invalidateRenders();
 		emit dataChanged(index(0), index(rowCount() - 1), {Qt::DecorationRole});
 	}
 }
@@ -228,7 +225,7 @@ bool IconModel::isGrayscale() const {
 void IconModel::setBackgroundColor(const QColor &color) {
 	if (m_backgroundColor != color) {
 		m_backgroundColor = color;
-		m_pixmapCache.clear();
+		invalidateRenders();
 		emit dataChanged(index(0), index(rowCount() - 1), {Qt::DecorationRole});
 	}
 }
@@ -242,7 +239,7 @@ void IconModel::setStrokeWidth(int width) {
 	width = qBound(0, width, maxValue);
 	if (m_strokeWidth != width) {
 		m_strokeWidth = width;
-		m_pixmapCache.clear();
+		invalidateRenders();
 		emit dataChanged(index(0), index(rowCount() - 1), {Qt::DecorationRole});
 	}
 }
@@ -250,7 +247,7 @@ void IconModel::setStrokeWidth(int width) {
 void IconModel::setStrokeMode(bool fillBased) {
 	if (m_fillBasedStroke != fillBased) {
 		m_fillBasedStroke = fillBased;
-		m_pixmapCache.clear();
+		invalidateRenders();
 		emit dataChanged(index(0), index(rowCount() - 1), {Qt::DecorationRole});
 	}
 }
@@ -259,12 +256,14 @@ int IconModel::strokeWidth() const {
 	return m_strokeWidth;
 }
 
+bool IconModel::isFillBasedStroke() const {
+	return m_fillBasedStroke;
+}
+
 void IconModel::setFilter(const QString &filter) {
 	if (m_filter != filter) {
-		beginResetModel();
 		m_filter = filter;
-		rebuildFilteredList();
-		endResetModel();
+		applyFilteredIndices(matchingIndices());
 		emit filterChanged();
 	}
 }
@@ -273,6 +272,118 @@ QString IconModel::filter() const {
 	return m_filter;
 }
 
+void IconModel::setViewport(int firstRow, int lastRow) {
+	m_viewFirst = firstRow;
+	m_viewLast = lastRow;
+
+	// Re-rank queued renders and cancel the ones that scrolled out of range
+	const QList<int> cancelled = m_renderer->reprioritize([this](int index) {
+		return renderPriority(rowForIndex(index));
+	});
+	for (int index : cancelled)
+		m_pendingRenders.remove(index);
+
+	if (firstRow < 0 || !svgIconList())
+		return;
+
+	// Prefetch outwards from the viewport, nearest rows first
+	const int rows = rowCount();
+	const IconAtlas *atlas = findAtlas(m_iconSize);
+	for (int distance = 1; distance <= m_prefetchBand; ++distance) {
+		int above = firstRow - distance;
+		int below = lastRow + distance;
+		if (above < 0 && below >= rows)
+			break;
+		for (int row : { below, above }) {
+			if (row < 0 || row >= rows)
+				continue;
+			int actualIndex = m_filteredIndices[row];
+			const IconRenderKey key = renderKey(actualIndex);
+			if (!m_pixmapCache.contains(key) && !(atlas && atlas->contains(key)))
+				requestRender(actualIndex, distance);
+		}
+	}
+}
+
+void IconModel::setPrefetchBand(int rows) {
+	m_prefetchBand = qMax(0, rows);
+}
+
+int IconModel::prefetchBand() const {
+	return m_prefetchBand;
+}
+
+quint64 IconModel::generation() const {
+	return m_generation;
+}
+
+void IconModel::setCacheLimit(qint64 bytes) {
+	m_pixmapCache.setMaxBytes(bytes);
+}
+
+ThumbnailPixmapCache::Stats IconModel::cacheStats() const {
+	return m_pixmapCache.stats();
+}
+
+void IconModel::setAtlasEnabled(bool enabled) {
+	if (m_atlasEnabled == enabled)
+		return;
+	m_atlasEnabled = enabled;
+	m_atlases.clear();
+	if (enabled)
+		useAtlas(m_iconSize);
+}
+
+bool IconModel::isAtlasEnabled() const {
+	return m_atlasEnabled;
+}
+
+void IconModel::setCompiledPathsEnabled(bool enabled) {
+	// Compiled thumbnails are painted from QPainterPath, so edge antialiasing
+	// is close to QSvgRenderer's but not pixel-identical; exports always go
+	// through renderSvg(). The render key records the setting, so thumbnails
+	// from the other path are not shown next to new ones.
+	if (m_compiledPathsEnabled != enabled) {
+		m_compiledPathsEnabled = enabled;
+		invalidateRenders();
+		emit dataChanged(index(0), index(rowCount() - 1), {Qt::DecorationRole});
+	}
+}
+
+bool IconModel::isCompiledPathsEnabled() const {
+	return m_compiledPathsEnabled;
+}
+
+bool IconModel::atlasSlot(int row, const QImage **page, QRect *rect) const {
+	if (row < 0 || row >= static_cast<int>(m_filteredIndices.size()))
+		return false;
+	IconAtlas *atlas = findAtlas(m_iconSize);
+	return atlas && atlas->lookup(renderKey(m_filteredIndices[row]), page, rect);
+}
+
+IconAtlas *IconModel::findAtlas(int size) const {
+	if (!m_atlasEnabled)
+		return nullptr;
+	for (IconAtlas &atlas : m_atlases) {
+		if (atlas.slotSize() == size)
+			return &atlas;
+	}
+	return nullptr;
+}
+
+void IconModel::useAtlas(int size) {
+	auto it = std::find_if(m_atlases.begin(), m_atlases.end(),
+						   [size](const IconAtlas &atlas) { return atlas.slotSize() == size; });
+	if (it != m_atlases.end()) {
+		m_atlases.splice(m_atlases.begin(), m_atlases, it);
+		return;
+	}
+	m_atlases.emplace_front();
+	m_atlases.front().setSlotSize(size);
+	while (m_atlases.size() > c_maxAtlases)
+		m_atlases.pop_back();
+}
+
 QPixmap IconModel::getIconPixmap(int index) const {
 	return renderIcon(index);
 }
@@ -281,11 +392,10 @@ QPixmap IconModel::getIconPixmapAtSize(int index, int size) const {
 	if (!m_iconList || index < 0 || index >= static_cast<int>(m_allIcons.size()))
 		return QPixmap();
 
-	int actualIndex = m_allIcons[index].index;
-
-	if (auto *bitmap = bitmapIconList()) {
+	int bitmapIndex = -1;
+	if (auto *bitmap = bitmapSource(index, &bitmapIndex)) {
 		// Bitmap icon - get and scale
-		QPixmap pixmap = bitmap->getPixmap(actualIndex);
+		QPixmap pixmap = bitmap->getPixmap(bitmapIndex);
 		if (!pixmap.isNull() && (pixmap.width() != size || pixmap.height() != size)) {
 			pixmap = pixmap.scaled(size, size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
 		}
@@ -300,35 +410,12 @@ QPixmap IconModel::getIconPixmapAtSize(int index, int size) const {
 		return pixmap;
 	}
 
-	if (auto *svg = svgIconList()) {
+	if (svgIconList()) {
 		// SVG icon - render at requested size
-		QString svgSource = svg->getSource(actualIndex);
+		QByteArray svgSource = renderSource(index);
 		if (svgSource.isEmpty())
 			return QPixmap();
-
-		// Resolve entities if present
-		EntityMap entities = currentEntities(index);
-		if (!entities.isEmpty()) {
-			svgSource = SVGIconList::resolveEntities(svgSource, entities);
-		}
-
-		// Apply stroke width adjustment
-		svgSource = adjustStrokeWidth(svgSource, m_strokeWidth, m_fillBasedStroke);
-
-		QSvgRenderer renderer(svgSource.toUtf8());
-		if (!renderer.isValid())
-			return QPixmap();
-
-		QPixmap pixmap(size, size);
-		pixmap.fill(m_backgroundColor);
-
-		QPainter painter(&pixmap);
-		painter.setRenderHint(QPainter::Antialiasing);
-		painter.setRenderHint(QPainter::SmoothPixmapTransform);
-		renderer.render(&painter);
-		painter.end();
-
-		return pixmap;
+		return QPixmap::fromImage(IconRenderer::renderSvg(svgSource, size, m_backgroundColor));
 	}
 
 	return QPixmap();
@@ -338,23 +425,24 @@ QString IconModel::getIconSvg(int index) const {
 	if (!m_iconList || index < 0 || index >= static_cast<int>(m_allIcons.size()))
 		return QString();
 	if (auto *svg = svgIconList()) {
-		QString source = svg->getSource(index);
-		// Resolve entities if present
+		// Entities, stroke width and "currentColor" applied in one pass
 		EntityMap entities = currentEntities(index);
-		if (!entities.isEmpty()) {
-			source = SVGIconList::resolveEntities(source, entities);
-		}
-		// Apply stroke width adjustment
-		source = adjustStrokeWidth(source, m_strokeWidth, m_fillBasedStroke);
-		// Replace "currentColor" with actual fill color
-		if (m_fillColor.isValid() && m_fillColor.alpha() > 0) {
-			source.replace("currentColor", m_fillColor.name());
-		}
-		return source;
+		SvgRewriteOptions options;
+		options.strokeSliderPos = m_strokeWidth;
+		options.fillBasedStroke = m_fillBasedStroke;
+		if (m_fillColor.isValid() && m_fillColor.alpha() > 0)
+			options.currentColor = m_fillColor.name();
+		if (!entities.isEmpty())
+			options.entities = &entities;
+		return QString::fromUtf8(rewriteSvg(svg->getSource(index), options));
 	}
 	return QString(); // No SVG for bitmap icons
 }
 
+QByteArray IconModel::getIconRenderSource(int index) const {
+	return renderSource(index);
+}
+
 QString IconModel::getIconName(int index) const {
 	if (index < 0 || index >= static_cast<int>(m_allIcons.size()))
 		return QString();
@@ -401,7 +489,8 @@ void IconModel::setIconEntities(int index, const EntityMap &entities) {
 	if (index < 0 || index >= static_cast<int>(m_allIcons.size()))
 		return;
 	m_customEntities[index] = entities;
-	m_pixmapCache.remove(index);  // Force re-render
+	m_templates.remove(index);
+	m_pendingRenders.remove(index);  // The new entities give a new cache key
 }
 
 EntityMap IconModel::currentEntities(int index) const {
@@ -411,12 +500,16 @@ EntityMap IconModel::currentEntities(int index) const {
 }
 
 void IconModel::refresh() {
-	m_pixmapCache.clear();
+	invalidateRenders();
 	emit dataChanged(index(0), index(rowCount() - 1));
 }
 
 void IconModel::clearCache() {
+	invalidateRenders();
 	m_pixmapCache.clear();
+	m_atlases.clear();
+	if (m_atlasEnabled)
+		useAtlas(m_iconSize);
 }
 
 QPixmap IconModel::renderIcon(int index) const {
@@ -424,53 +517,35 @@ QPixmap IconModel::renderIcon(int index) const {
 		return QPixmap();
 
 	// Check cache first
-	if (QPixmap *cached = m_pixmapCache.object(index))
+	const IconRenderKey key = renderKey(index);
+	if (const QPixmap *cached = m_pixmapCache.find(key))
 		return *cached;
 
-	int actualIndex = m_allIcons[index].index;
+	int bitmapIndex = -1;
+	BitmapIconList *bitmap = bitmapSource(index, &bitmapIndex);
 	QPixmap pixmap;
 
-	if (auto *bitmap = bitmapIconList()) {
+	if (bitmap) {
 		// Bitmap icon - get directly from resource
-		pixmap = bitmap->getPixmap(actualIndex);
+		pixmap = bitmap->getPixmap(bitmapIndex);
 		if (!pixmap.isNull() && (pixmap.width() != m_iconSize || pixmap.height() != m_iconSize)) {
 			pixmap = pixmap.scaled(m_iconSize, m_iconSize,
 								   Qt::KeepAspectRatio, Qt::SmoothTransformation);
 		}
-	} else if (auto *svg = svgIconList()) {
+	} else if (svgIconList()) {
 		// SVG icon - render from source
-		QString svgSource = svg->getSource(actualIndex);
+		QByteArray svgSource = renderSource(index);
 		if (svgSource.isEmpty())
 			return QPixmap();
-
-		// Resolve entities if present
-		EntityMap entities = currentEntities(index);
-		if (!entities.isEmpty()) {
-			svgSource = SVGIconList::resolveEntities(svgSource, entities);
-		}
-
-		// Apply stroke width adjustment
-		svgSource = adjustStrokeWidth(svgSource, m_strokeWidth, m_fillBasedStroke);
-
-		QSvgRenderer renderer(svgSource.toUtf8());
-		if (!renderer.isValid())
-			return QPixmap();
-
-		pixmap = QPixmap(m_iconSize, m_iconSize);
-		pixmap.fill(m_backgroundColor);
-
-		QPainter painter(&pixmap);
-		painter.setRenderHint(QPainter::Antialiasing);
-		painter.setRenderHint(QPainter::SmoothPixmapTransform);
-		renderer.render(&painter);
-		painter.end();
+		pixmap = QPixmap::fromImage(IconRenderer::renderCached(svgSource, m_iconSize,
+															   m_backgroundColor, key));
 	}
 
 	if (pixmap.isNull())
 		return pixmap;
 
 	// Apply background for bitmap icons if needed
-	if (isBitmapMode() && m_backgroundColor.alpha() > 0) {
+	if (bitmap && m_backgroundColor.alpha() > 0) {
 		QPixmap withBg(pixmap.size());
 		withBg.fill(m_backgroundColor);
 		QPainter painter(&withBg);
@@ -480,35 +555,326 @@ QPixmap IconModel::renderIcon(int index) const {
 	}
 
 	// Cache the result
-	m_pixmapCache.insert(index, new QPixmap(pixmap));
+	m_pixmapCache.insert(key, pixmap);
 
 	return pixmap;
 }
 
-void IconModel::rebuildFilteredList() {
-	m_filteredIndices.clear();
+QVariant IconModel::iconDecoration(int index) const {
+	const IconRenderKey key = renderKey(index);
+	if (const QPixmap *cached = m_pixmapCache.find(key))
+		return *cached;
+
+	// Only reached by callers that do not paint from the atlas directly; the
+	// copy goes to the pixmap cache so it is made once, not on every call
+	const QImage *page = nullptr;
+	QRect rect;
+	IconAtlas *atlas = findAtlas(m_iconSize);
+	if (atlas && atlas->lookup(key, &page, &rect)) {
+		QPixmap pixmap = QPixmap::fromImage(page->copy(rect));
+		m_pixmapCache.insert(key, pixmap);
+		return pixmap;
+	}
+
+	// Bitmap icons are plain PNG decodes, only SVG parsing is moved off the GUI thread
+	if (!svgIconList() || isBitmapIcon(index))
+		return renderIcon(index);
+
+	requestRender(index, 0);  // Asked for by the view, so it is on screen
+
+	if (m_placeholder.isNull()) {
+		m_placeholder = QPixmap(m_iconSize, m_iconSize);
+		m_placeholder.fill(m_backgroundColor);
+	}
+	return m_placeholder;
+}
+
+QByteArray IconModel::renderSource(int index) const {
+	auto *svg = svgIconList();
+	if (!svg || index < 0 || index >= static_cast<int>(m_allIcons.size()))
+		return QByteArray();
+
+	// Fast path: splice current colors and stroke width into the compiled source
+	if (const SvgTemplate *tpl = sourceTemplate(index)) {
+		return tpl->instantiate(m_fillColor.name().toLatin1(), m_toneColor.name().toLatin1(),
+								m_strokeWidth, m_fillBasedStroke);
+	}
+
+	QString svgSource = svg->getSource(m_allIcons[index].index);
+	if (svgSource.isEmpty())
+		return QByteArray();
+
+	// Entities and stroke width applied in one pass
+	EntityMap entities = currentEntities(index);
+	SvgRewriteOptions options;
+	options.strokeSliderPos = m_strokeWidth;
+	options.fillBasedStroke = m_fillBasedStroke;
+	if (!entities.isEmpty())
+		options.entities = &entities;
+	return rewriteSvg(svgSource, options);
+}
+
+const SvgTemplate *IconModel::sourceTemplate(int index) const {
+	auto *svg = svgIconList();
+	auto *twoTone = dynamic_cast<SVGTwoToneIconList*>(svg);
+
+	// With clNone the lists emit a structurally different source (currentColor,
+	// missing fill attributes), which a color slot cannot reproduce
+	if (!svg || !m_fillColor.isValid() || m_fillColor == clNone)
+		return nullptr;
+	if (twoTone && (!m_toneColor.isValid() || m_toneColor.alpha() == 0 || m_toneColor == clNone))
+		return nullptr;
+
+	if (SvgTemplate *cached = m_templates.object(index))
+		return cached->isValid() ? cached : nullptr;
+
+	// Generate the source once with sentinel colors, then restore the real ones
+	int actualIndex = m_allIcons[index].index;
+	svg->setFillColor(SvgTemplate::fillSentinel());
+	if (twoTone)
+		twoTone->setToneColor(SvgTemplate::toneSentinel());
+	QString source = svg->getSource(actualIndex);
+	svg->setFillColor(m_fillColor);
+	if (twoTone)
+		twoTone->setToneColor(m_toneColor);
+
+	EntityMap entities = currentEntities(index);
+	QByteArray text;
+	if (!entities.isEmpty()) {
+		SvgRewriteOptions options;
+		options.entities = &entities;
+		text = rewriteSvg(source, options);
+	} else {
+		text = source.toUtf8();
+	}
+
+	auto *tpl = new SvgTemplate(SvgTemplate::compile(text, svg->getBody(actualIndex)));
+	m_templates.insert(index, tpl, qMax(1, tpl->size()));
+	tpl = m_templates.object(index);
+	return (tpl && tpl->isValid()) ? tpl : nullptr;
+}
+
+IconRenderKey IconModel::renderKey(int index) const {
+	IconRenderKey key;
+	if (!m_iconList || index < 0 || index >= static_cast<int>(m_allIcons.size()))
+		return key;
+
+	key.libraryName = m_libraryName;
+	key.index = m_allIcons[index].index;
+	key.cellSize = m_iconSize;
+	key.backgroundColor = m_backgroundColor.rgba();
+	if (isBitmapIcon(index)) {
+		// Colors and stroke width do not apply to bitmaps
+		key.grayscale = m_grayscale;
+		return key;
+	}
+	key.fillColor = m_fillColor.rgba();
+	key.toneColor = m_toneColor.rgba();
+	key.strokeWidth = m_strokeWidth;
+	key.fillBasedStroke = m_fillBasedStroke;
+	key.compiledPaths = m_compiledPathsEnabled && m_compiledSource;
+
+	auto custom = m_customEntities.constFind(index);
+	if (custom != m_customEntities.constEnd()) {
+		for (auto it = custom->cbegin(); it != custom->cend(); ++it)
+			key.entitiesHash = key.entitiesHash * 31 + qHash(it.key()) * 17 + qHash(it.value());
+		key.entitiesHash |= 1;  // Keep overrides distinct from "no overrides"
+	}
+	return key;
+}
+
+bool IconModel::compiledIcon(int index, CompiledIcon *icon) const {
+	// Custom entities only exist for icons with entities, which are never compiled
+	const CompiledPathSource *source = m_compiledSource;
+	if (!m_compiledPathsEnabled || !source || m_customEntities.contains(index)
+		|| index < 0 || index >= static_cast<int>(m_allIcons.size()))
+		return false;
+
+	const char *scale = nullptr;
+	icon->paths = source->getCompiledPaths(m_allIcons[index].index, &scale);
+	if (icon->paths.isEmpty())
+		return false;
+	icon->viewBox = m_iconList->getBaseSize();
+	icon->scale = scale ? QByteArray(scale).toFloat() : 0.0f;
+	icon->style = source->getCompiledStyle();
+	// Sources are written with QColor::name(), which drops alpha; clNone means currentColor
+	icon->color = (m_fillColor.isValid() && m_fillColor != clNone) ? QColor(m_fillColor.rgb()) : QColor(Qt::black);
+	icon->strokeSliderPos = m_strokeWidth;
+	icon->fillBasedStroke = m_fillBasedStroke;
+	return true;
+}
+
+void IconModel::requestRender(int index, int priority) const {
+	if (m_pendingRenders.contains(index) || isBitmapIcon(index))
+		return;
+	// Failed renders stay pending, so they are not retried until the next invalidation
+	m_pendingRenders.insert(index);
+
+	IconRenderJob job;
+	job.index = index;
+	job.generation = m_generation;
+	job.priority = priority;
+	if (!compiledIcon(index, &job.compiled))
+		job.svg = renderSource(index);
+	job.size = m_iconSize;
+	job.background = m_backgroundColor;
+	job.key = renderKey(index);
+	if (!job.svg.isEmpty() || !job.compiled.isNull())
+		m_renderer->enqueue(job);
+}
+
+int IconModel::renderPriority(int row) const {
+	if (row < 0)
+		return -1;  // Filtered out
+	if (m_viewFirst < 0 || (row >= m_viewFirst && row <= m_viewLast))
+		return 0;
+	int distance = (row < m_viewFirst) ? m_viewFirst - row : row - m_viewLast;
+	return (distance <= m_prefetchBand) ? distance : -1;
+}
+
+void IconModel::bumpGeneration() {
+	// Drops queued renders and discards running ones when they finish
+	m_renderer->setGeneration(++m_generation);
+	m_pendingRenders.clear();
+}
+
+void IconModel::invalidateRenders() {
+	// The cache is keyed by render parameters, so it survives setting changes
+	bumpGeneration();
+	m_placeholder = QPixmap();
+}
+
+void IconModel::onIconsRendered(const QList<IconRenderResult> &results) {
+	int firstRow = rowCount();
+	int lastRow = -1;
+
+	for (const auto &result : results) {
+		if (result.image.isNull())
+			continue;
+		m_pendingRenders.remove(result.index);
+		IconAtlas *atlas = findAtlas(result.key.cellSize);
+		if (!atlas || !atlas->insert(result.key, result.image))
+			m_pixmapCache.insert(result.key, QPixmap::fromImage(result.image));
+
+		int row = rowForIndex(result.index);
+		if (row >= 0) {
+			firstRow = qMin(firstRow, row);
+			lastRow = qMax(lastRow, row);
+		}
+	}
+
+	// One update per batch; the view only repaints rows that are visible
+	if (lastRow >= 0)
+		emit dataChanged(index(firstRow), index(lastRow), {Qt::DecorationRole});
+}
+
+int IconModel::rowForIndex(int index) const {
+	// m_filteredIndices is always built in ascending order
+	auto it = std::lower_bound(m_filteredIndices.begin(), m_filteredIndices.end(), index);
+	if (it == m_filteredIndices.end() || *it != index)
+		return -1;
+	return static_cast<int>(it - m_filteredIndices.begin());
+}
+
+std::vector<int> IconModel::matchingIndices() {
+	std::vector<int> indices;
 
 	if (m_filter.isEmpty()) {
 		// No filter - show all icons
-		m_filteredIndices.reserve(m_allIcons.size());
+		indices.reserve(m_allIcons.size());
 		for (size_t i = 0; i < m_allIcons.size(); ++i) {
-			m_filteredIndices.push_back(static_cast<int>(i));
+			indices.push_back(static_cast<int>(i));
 		}
 	} else {
-		// Filter by name (case-insensitive)
-		QRegularExpression regex(
-			QRegularExpression::escape(m_filter),
-			QRegularExpression::CaseInsensitiveOption
-		);
+		// Match names, tags, aliases and categories through the index
+		if (m_searchIndex.documentCount() != static_cast<int>(m_allIcons.size()))
+			buildSearchIndex();
+		indices = m_searchIndex.search(m_filter);
+	}
+	return indices;
+}
+
+void IconModel::applyFilteredIndices(std::vector<int> indices) {
+	// Both lists are ascending, so one merge pass yields the removed and
+	// inserted runs. Rows are given as positions in the list as edited so
+	// far, in the order the edits must be applied.
+	struct Run {
+		bool insert;
+		int row;
+		int first;  // Insert only: range in indices
+		int count;
+	};
+	std::vector<Run> runs;
+
+	const int oldCount = static_cast<int>(m_filteredIndices.size());
+	const int newCount = static_cast<int>(indices.size());
+	int oldPos = 0;
+	int newPos = 0;
+	int row = 0;
+	while (oldPos < oldCount || newPos < newCount) {
+		if (oldPos < oldCount && newPos < newCount && m_filteredIndices[oldPos] == indices[newPos]) {
+			++oldPos;
+			++newPos;
+			++row;
+			continue;
+		}
+		int end = oldPos;
+		while (end < oldCount && (newPos >= newCount || m_filteredIndices[end] < indices[newPos]))
+			++end;
+		if (end > oldPos) {
+			runs.push_back({ false, row, 0, end - oldPos });
+			oldPos = end;
+			continue;
+		}
+		end = newPos;
+		while (end < newCount && (oldPos >= oldCount || indices[end] < m_filteredIndices[oldPos]))
+			++end;
+		runs.push_back({ true, row, newPos, end - newPos });
+		row += end - newPos;
+		newPos = end;
+	}
 
-		for (size_t i = 0; i < m_allIcons.size(); ++i) {
-			if (m_allIcons[i].name.contains(regex)) {
-				m_filteredIndices.push_back(static_cast<int>(i));
-			}
+	if (runs.empty())
+		return;
+
+	if (static_cast<int>(runs.size()) > c_maxFilterRuns) {
+		// Too fragmented for row signals: reset once. A layout change may
+		// not alter the row count, so it is no option here.
+		beginResetModel();
+		m_filteredIndices = std::move(indices);
+		endResetModel();
+		return;
+	}
+
+	for (const Run &run : runs) {
+		if (run.insert) {
+			beginInsertRows(QModelIndex(), run.row, run.row + run.count - 1);
+			m_filteredIndices.insert(m_filteredIndices.begin() + run.row,
+									 indices.begin() + run.first, indices.begin() + run.first + run.count);
+			endInsertRows();
+		} else {
+			beginRemoveRows(QModelIndex(), run.row, run.row + run.count - 1);
+			m_filteredIndices.erase(m_filteredIndices.begin() + run.row,
+									m_filteredIndices.begin() + run.row + run.count);
+			endRemoveRows();
 		}
 	}
 }
 
+void IconModel::buildSearchIndex() {
+	std::vector<IconSearchDocument> documents;
+	documents.reserve(m_allIcons.size());
+	for (size_t i = 0; i < m_allIcons.size(); ++i) {
+		int index = static_cast<int>(i);
+		IconSearchDocument document;
+		document.name = m_allIcons[i].name;
+		document.keywords = getIconTags(index) + getIconAliases(index);
+		document.category = getIconCategory(index);
+		documents.push_back(document);
+	}
+	m_searchIndex.build(documents);
+}
+
 // ============================================================================
 // IconCollectionRegistry
 // ============================================================================
@@ -545,7 +911,7 @@ SVGIconList *IconCollectionRegistry::createIconList(const QString &collectionId,
 		if (coll->hasStyle(IconStyle::Filled) && coll->hasStyle(IconStyle::Outline)) {
 			auto filledFactory = coll->styles.at(IconStyle::Filled);
 			auto outlineFactory = coll->styles.at(IconStyle::Outline);
-			return new TwoToneIconList(filledFactory(size), outlineFactory(size));
+			return new TwoToneIconList(filledFactory(size), outlineFactory(size), twoToneEntry(collectionId, size));
 		}
 		// Fallback to Outline if TwoTone not possible
 		style = IconStyle::Outline;
@@ -591,6 +957,40 @@ BitmapIconList *IconCollectionRegistry::createBitmapList(const QString &collecti
 	return coll->factory(actualSize);
 }
 
+int IconCollectionRegistry::iconCount(const QString &collectionId, IconStyle style, int size) const {
+	const IconCatalogEntry *entry = catalogEntry(collectionId, iconStyleToString(style), size, false);
+	return entry ? entry->count : -1;
+}
+
+int IconCollectionRegistry::bitmapIconCount(const QString &collectionId, int size) const {
+	const IconCatalogEntry *entry = catalogEntry(collectionId, QStringLiteral("Color"), size, true);
+	return entry ? entry->count : -1;
+}
+
+const IconCatalogEntry *IconCollectionRegistry::catalogEntry(const QString &collectionId, const QString &style,
+															 int size, bool bitmap) {
+	const QByteArray collection = collectionId.toUtf8();
+	const QByteArray styleName = style.toUtf8();
+	for (int i = 0; i < icon_catalog_count; ++i) {
+		const IconCatalogEntry &entry = icon_catalog[i];
+		if (entry.size == size && (entry.bitmap != 0) == bitmap
+			&& std::strcmp(entry.collection, collection.constData()) == 0
+			&& std::strcmp(entry.style, styleName.constData()) == 0)
+			return &entry;
+	}
+	return nullptr;
+}
+
+const IconTwoToneEntry *IconCollectionRegistry::twoToneEntry(const QString &collectionId, int size) {
+	const QByteArray collection = collectionId.toUtf8();
+	for (int i = 0; i < icon_twotone_catalog_count; ++i) {
+		const IconTwoToneEntry &entry = icon_twotone_catalog[i];
+		if (entry.size == size && std::strcmp(entry.collection, collection.constData()) == 0)
+			return &entry;
+	}
+	return nullptr;
+}
+
 QStringList IconCollectionRegistry::allCollectionNames() const {
 	QStringList names;
 	for (const auto &coll : m_collections)
@@ -6,13 +6,25 @@
 #include <QPixmap>
 #include <QSvgRenderer>
 #include <QPainter>
+#include <QSet>
 #include <QCache>
 
+#include <list>
 #include <memory>
 #include <vector>
 #include <map>
 
 #include "library/lib_svgiconlist.h"
+#include "library/lib_catalog.h"
+#include "library/lib_contentstore.h"
+#include "library/lib_nametable.h"
+#include "iconrenderer.h"
+#include "thumbnailcache.h"
+#include "iconatlas.h"
+#include "svgsource.h"
+#include "iconsearch.h"
+
+class GlobalIconList;
 
 // Icon style types (matching original Delphi implementation)
 enum class IconStyle {
@@ -75,6 +87,7 @@ public:
 	void setStrokeWidth(int width);
 	void setStrokeMode(bool fillBased);  // true = absolute values, false = relative scaling
 	int strokeWidth() const;
+	bool isFillBasedStroke() const;
 
 	// Grayscale mode (for bitmap icons)
 	void setGrayscale(bool enabled);
@@ -84,10 +97,35 @@ public:
 	void setFilter(const QString &filter);
 	QString filter() const;
 
+	// Render scheduling: visible rows render first, then a prefetch band of
+	// rows above and below; queued work outside that band is cancelled
+	void setViewport(int firstRow, int lastRow);
+	void setPrefetchBand(int rows);
+	int prefetchBand() const;
+
+	// Bumped whenever the model state that thumbnails depend on is invalidated
+	quint64 generation() const;
+
+	// In-memory thumbnail cache, bounded in bytes
+	void setCacheLimit(qint64 bytes);
+	ThumbnailPixmapCache::Stats cacheStats() const;
+
+	// Atlas mode: SVG thumbnails are packed into shared pages and painted as
+	// sub-rects, see atlasSlot(). Each cell size has its own atlas and the
+	// last few sizes are kept, so switching back does not re-render.
+	void setAtlasEnabled(bool enabled);
+	bool isAtlasEnabled() const;
+	bool atlasSlot(int row, const QImage **page, QRect *rect) const;
+
+	// Icons of lists with compiled path records are drawn without QSvgRenderer
+	void setCompiledPathsEnabled(bool enabled);
+	bool isCompiledPathsEnabled() const;
+
 	// Get icon at index
 	QPixmap getIconPixmap(int index) const;
 	QPixmap getIconPixmapAtSize(int index, int size) const;
 	QString getIconSvg(int index) const;
+	QByteArray getIconRenderSource(int index) const;  // As rendered by getIconPixmapAtSize()
 	QString getIconName(int index) const;
 	QStringList getIconAliases(int index) const;
 	QStringList getIconTags(int index) const;
@@ -109,12 +147,32 @@ signals:
 
 private:
 	QPixmap renderIcon(int index) const;
-	void rebuildFilteredList();
+	QVariant iconDecoration(int index) const;
+	QByteArray renderSource(int index) const;
+	const SvgTemplate *sourceTemplate(int index) const;
+	IconRenderKey renderKey(int index) const;
+	bool isBitmapIcon(int index) const;
+	BitmapIconList *bitmapSource(int index, int *bitmapIndex) const;
+	IconAtlas *findAtlas(int size) const;
+	void useAtlas(int size);
+	bool compiledIcon(int index, CompiledIcon *icon) const;
+	void requestRender(int index, int priority) const;
+	int renderPriority(int row) const;
+	void bumpGeneration();
+	void invalidateRenders();
+	void onIconsRendered(const QList<IconRenderResult> &results);
+	int rowForIndex(int index) const;
+	std::vector<int> matchingIndices();
+	void applyFilteredIndices(std::vector<int> indices);
+	void buildSearchIndex();
 
 	IconList *m_iconList = nullptr;
+	GlobalIconList *m_globalList = nullptr;  // m_iconList in "All Libraries" mode
+	const CompiledPathSource *m_compiledSource = nullptr;  // m_iconList if it has path records
 	std::vector<IconEntry> m_allIcons;
 	std::vector<int> m_filteredIndices;
 	QString m_filter;
+	IconSearchIndex m_searchIndex;
 
 	int m_iconSize = 32;
 	QColor m_fillColor = clNone;
@@ -124,107 +182,192 @@ private:
 	bool m_fillBasedStroke = true;  // true = absolute values, false = relative scaling
 	bool m_grayscale = false;
 
-	mutable QCache<int, QPixmap> m_pixmapCache;
+	QString m_libraryName;               // Cached IconList::getLibraryName()
+	mutable ThumbnailPixmapCache m_pixmapCache;
+	mutable std::list<IconAtlas> m_atlases;  // One per cell size, current size first
+	bool m_atlasEnabled = false;
+	bool m_compiledPathsEnabled = true;
+	IconRenderer *m_renderer;
+	mutable QSet<int> m_pendingRenders;  // Icons queued on the renderer
+	mutable QPixmap m_placeholder;       // Shown until a thumbnail is ready
+	quint64 m_generation = 0;
+	int m_viewFirst = -1;                // Visible rows reported by the view
+	int m_viewLast = -1;
+	int m_prefetchBand = 128;
+	mutable QCache<int, SvgTemplate> m_templates;  // Compiled sources, cost in bytes
 	mutable QMap<int, EntityMap> m_customEntities;  // Custom entity values per icon
 };
 
-// TwoTone icon list - combines outline and filled lists with name-based mapping
+// TwoTone icon list - combines outline and filled lists, paired by name
 class TwoToneIconList : public SVGTwoToneIconList {
 	std::unique_ptr<SVGIconList> m_filled;
 	std::unique_ptr<SVGIconList> m_outline;
 	QColor m_fillColor = Qt::black;
 	QColor m_toneColor = QColor(200, 200, 200);
 
-	// Mapping: index in this list -> {outlineIdx, filledIdx}
-	struct IconMapping {
-		int outlineIdx;
-		int filledIdx;  // -1 if no filled version exists
-	};
-	std::vector<IconMapping> m_mapping;
-	QMap<QString, int> m_filledNameToIdx;
-
+	// Mapping: index in this list -> {outline, filled}; either the generated
+	// pairs from the catalog or m_builtPairs
+	const IconTwoTonePair *m_pairs = nullptr;
+	int m_pairCount = 0;
+	std::vector<IconTwoTonePair> m_builtPairs;
+
+	// Layers as header/body parts, null if a list does not provide them
+	const SvgSourceParts *m_filledParts = nullptr;
+	const SvgSourceParts *m_outlineParts = nullptr;
+
+	// Lists without generated pairs: open addressing over name hashes, with
+	// all storage allocated up front. Names match like the generator's
+	// pairing: ASCII case-insensitive, "-fill" dropped from filled names
+	// only, last duplicate wins. Hashes come from the lists' generated name
+	// tables when they have them.
 	void buildMapping() {
-		// Build name->index map for filled icons
-		m_filledNameToIdx.clear();
-		for (int i = 0; i < m_filled->getCount(); ++i) {
-			QString name = m_filled->getName(i);
-			// Remove "-fill" suffix if present for matching
-			if (name.endsWith("-fill"))
-				name = name.left(name.length() - 5);
-			m_filledNameToIdx[name.toLower()] = i;
+		const auto *filledNames = dynamic_cast<const IconNameSource*>(m_filled.get());
+		const auto *outlineNames = dynamic_cast<const IconNameSource*>(m_outline.get());
+		const int filledCount = m_filled->getCount();
+		const int outlineCount = m_outline->getCount();
+		quint32 capacity = 16;
+		while (capacity < quint32(filledCount) * 2)
+			capacity <<= 1;
+		const quint32 mask = capacity - 1;
+		std::vector<int> slots(capacity, -1);
+		std::vector<quint32> hashes(filledCount);
+
+		for (int i = 0; i < filledCount; ++i) {
+			const QString name = m_filled->getName(i);
+			const QStringView key = IconNameTable::key(name);
+			const quint32 hash = (filledNames && key.size() == name.size())
+				? IconNameTable(filledNames->getNameTable()).hash(i) : IconNameTable::hashName(key);
+			hashes[i] = hash;
+			for (quint32 slot = hash & mask; ; slot = (slot + 1) & mask) {
+				if (slots[slot] < 0 || (hashes[slots[slot]] == hash
+					&& IconNameTable::compareFolded(IconNameTable::key(m_filled->getName(slots[slot])), key) == 0)) {
+					slots[slot] = i;
+					break;
+				}
+			}
 		}
 
-		// Build mapping for outline icons that have filled counterparts
-		m_mapping.clear();
-		for (int i = 0; i < m_outline->getCount(); ++i) {
-			QString outlineName = m_outline->getName(i).toLower();
-			auto it = m_filledNameToIdx.find(outlineName);
-			if (it != m_filledNameToIdx.end()) {
-				m_mapping.push_back({i, it.value()});
+		m_builtPairs.clear();
+		m_builtPairs.reserve(qMin(filledCount, outlineCount));
+		for (int i = 0; i < outlineCount; ++i) {
+			const QString name = m_outline->getName(i);
+			const quint32 hash = outlineNames
+				? IconNameTable(outlineNames->getNameTable()).hash(i) : IconNameTable::hashName(name);
+			for (quint32 slot = hash & mask; slots[slot] >= 0; slot = (slot + 1) & mask) {
+				if (hashes[slots[slot]] == hash
+					&& IconNameTable::compareFolded(IconNameTable::key(m_filled->getName(slots[slot])), name) == 0) {
+					m_builtPairs.push_back({ i, slots[slot] });
+					break;
+				}
 			}
 		}
+		m_pairs = m_builtPairs.data();
+		m_pairCount = static_cast<int>(m_builtPairs.size());
+	}
+
+	// Header ("<svg ...>") and body of a layer's source, as views into it
+	static bool splitLayer(QStringView svg, QStringView *header, QStringView *body) {
+		const qsizetype headerEnd = svg.indexOf(u'>');
+		if (headerEnd < 0)
+			return false;
+		*header = svg.left(headerEnd + 1);
+		*body = svg.mid(headerEnd + 1);
+		if (body->endsWith(QLatin1String("</svg>"), Qt::CaseInsensitive))
+			body->chop(6);
+		return true;
+	}
+
+	// Outline header and both layer bodies as the layers' getSource() writes
+	// them; lists without SvgSourceParts have their full sources split
+	bool layerParts(const IconTwoTonePair &pair, QString *header, QString *filledBody, QString *outlineBody) const {
+		if (m_filledParts && m_outlineParts) {
+			*header = m_outlineParts->getSourceHeader();
+			*filledBody = m_filledParts->getSourceBody(pair.filled);
+			*outlineBody = m_outlineParts->getSourceBody(pair.outline);
+			return true;
+		}
+		const QString filledSvg = m_filled->getSource(pair.filled);
+		const QString outlineSvg = m_outline->getSource(pair.outline);
+		QStringView outlineHeaderView, outlineBodyView, filledHeaderView, filledBodyView;
+		if (!splitLayer(outlineSvg, &outlineHeaderView, &outlineBodyView)
+			|| !splitLayer(filledSvg, &filledHeaderView, &filledBodyView))
+			return false;
+		*header = outlineHeaderView.toString();
+		*filledBody = filledBodyView.toString();
+		*outlineBody = outlineBodyView.toString();
+		return true;
+	}
+
+	// Same text as QColor::name(), written in place
+	static void appendColorName(QString &out, QColor color) {
+		static const char digits[] = "0123456789abcdef";
+		const QRgb rgb = color.rgb();
+		out += QLatin1Char('#');
+		for (int shift = 20; shift >= 0; shift -= 4)
+			out += QLatin1Char(digits[(rgb >> shift) & 0xf]);
 	}
 
 public:
-	TwoToneIconList(SVGIconList *filled, SVGIconList *outline)
+	// pairs: generated pairing for these two lists, or null to build one
+	TwoToneIconList(SVGIconList *filled, SVGIconList *outline, const IconTwoToneEntry *pairs = nullptr)
 		: m_filled(filled), m_outline(outline) {
 		// Set initial colors on sub-lists
 		m_outline->setFillColor(m_fillColor);
 		m_filled->setFillColor(m_toneColor);
-		// Build name-based mapping
-		buildMapping();
+		if (pairs && pairs->outline_count == m_outline->getCount() && pairs->filled_count == m_filled->getCount()) {
+			m_pairs = pairs->pairs;
+			m_pairCount = pairs->count;
+		} else {
+			buildMapping();
+		}
+		m_filledParts = dynamic_cast<const SvgSourceParts*>(m_filled.get());
+		m_outlineParts = dynamic_cast<const SvgSourceParts*>(m_outline.get());
 	}
 
-	int getCount() const override { return static_cast<int>(m_mapping.size()); }
+	int getCount() const override { return m_pairCount; }
 
 	QString getName(int index) const override {
-		if (index < 0 || index >= static_cast<int>(m_mapping.size()))
+		if (index < 0 || index >= m_pairCount)
 			return QString();
-		return m_outline->getName(m_mapping[index].outlineIdx);
+		return m_outline->getName(m_pairs[index].outline);
 	}
 
 	QString getBody(int index) const override {
-		if (index < 0 || index >= static_cast<int>(m_mapping.size()))
+		if (index < 0 || index >= m_pairCount)
 			return QString();
-		const auto &map = m_mapping[index];
-		QString body = m_filled->getBody(map.filledIdx);
-		body += m_outline->getBody(map.outlineIdx);
+		const IconTwoTonePair &pair = m_pairs[index];
+		QString body = m_filled->getBody(pair.filled);
+		body += m_outline->getBody(pair.outline);
 		return body;
 	}
 
 	QString getSource(int index) const override {
-		if (index < 0 || index >= static_cast<int>(m_mapping.size()))
+		if (index < 0 || index >= m_pairCount)
 			return QString();
 
-		const auto &map = m_mapping[index];
-
-		// Get full SVG source from both layers (colors are already applied via setFillColor/setToneColor)
-		QString filledSvg = m_filled->getSource(map.filledIdx);
-		QString outlineSvg = m_outline->getSource(map.outlineIdx);
-
-		// Extract SVG header from outline (preserves viewBox, stroke styling, etc.)
-		int headerEnd = outlineSvg.indexOf('>');
-		if (headerEnd < 0) return QString();
-		QString svgHeader = outlineSvg.left(headerEnd + 1);
-		QString outlineBody = outlineSvg.mid(headerEnd + 1);
-		outlineBody.replace(QLatin1String("</svg>"), QString(), Qt::CaseInsensitive);
-
-		// Extract body from filled (strip header and closing tag)
-		int filledHeaderEnd = filledSvg.indexOf('>');
-		if (filledHeaderEnd < 0) return QString();
-		QString filledBody = filledSvg.mid(filledHeaderEnd + 1);
-		filledBody.replace(QLatin1String("</svg>"), QString(), Qt::CaseInsensitive);
-
-		// Build tone color for wrapping filled layer
-		QString toneColorStr = (m_toneColor.isValid() && m_toneColor.alpha() > 0)
-			? m_toneColor.name() : QStringLiteral("#c8c8c8");
-
-		// Wrap filled content in a group with explicit fill (overrides parent's fill="none")
-		QString filledLayer = QStringLiteral("<g fill=\"%1\" stroke=\"none\">%2</g>")
-			.arg(toneColorStr, filledBody);
+		QString header, filledBody, outlineBody;
+		if (!layerParts(m_pairs[index], &header, &filledBody, &outlineBody))
+			return QString();
 
-		// Combine: header + wrapped filled content + outline content + closing tag
-		return svgHeader + filledLayer + outlineBody + QStringLiteral("</svg>");
+		// Outline header (viewBox, stroke styling) + <g fill="tone" stroke="none">
+		// filled </g> + outline + </svg>, written into one buffer; the group's
+		// explicit fill overrides the parent's fill="none"
+		static const QLatin1String groupOpen("<g fill=\"");
+		static const QLatin1String groupAttributes("\" stroke=\"none\">");
+		static const QLatin1String groupClose("</g>");
+		static const QLatin1String svgClose("</svg>");
+		QString source;
+		source.reserve(header.size() + groupOpen.size() + 7 + groupAttributes.size() + filledBody.size()
+					   + groupClose.size() + outlineBody.size() + svgClose.size());
+		source += header;
+		source += groupOpen;
+		appendColorName(source, (m_toneColor.isValid() && m_toneColor.alpha() > 0) ? m_toneColor : QColor(0xc8, 0xc8, 0xc8));
+		source += groupAttributes;
+		source += filledBody;
+		source += groupClose;
+		source += outlineBody;
+		source += svgClose;
+		return source;
 	}
 
 	QColor getFillColor() const override { return m_fillColor; }
@@ -295,6 +438,14 @@ public:
 	const BitmapCollection *findBitmapCollection(const QString &id) const;
 	BitmapIconList *createBitmapList(const QString &collectionId, int size) const;
 
+	// Icon counts from the generated catalog, without constructing a list;
+	// -1 if the list is not in the catalog (e.g. TwoTone composites)
+	int iconCount(const QString &collectionId, IconStyle style, int size) const;
+	int bitmapIconCount(const QString &collectionId, int size) const;
+	static const IconCatalogEntry *catalogEntry(const QString &collectionId, const QString &style,
+												int size, bool bitmap);
+	static const IconTwoToneEntry *twoToneEntry(const QString &collectionId, int size);
+
 	// Combined list for UI
 	QStringList allCollectionNames() const;
 	bool isBitmapCollection(const QString &displayName) const;
@@ -0,0 +1,158 @@
+#include "iconrenderer.h"
+
+#include <QPainter>
+#include <QSvgRenderer>
+#include <QThread>
+
+#include <algorithm>
+
+// Delay used to coalesce finished renders into one batch (about one frame)
+static const int c_batchInterval = 16;
+
+IconRenderer::IconRenderer(QObject *parent)
+	: QObject(parent)
+{
+	// Leave one core to the GUI thread
+	m_pool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() - 1));
+
+	m_batchTimer.setSingleShot(true);
+	m_batchTimer.setInterval(c_batchInterval);
+	connect(&m_batchTimer, &QTimer::timeout, this, &IconRenderer::flushResults);
+}
+
+IconRenderer::~IconRenderer() {
+	m_queue.clear();
+	m_pool.waitForDone();
+}
+
+void IconRenderer::enqueue(const IconRenderJob &job) {
+	if (job.generation != m_generation.load())
+		return;
+	m_queue.push_back(job);
+	dispatch();
+}
+
+void IconRenderer::setGeneration(quint64 generation) {
+	if (m_generation.load() == generation)
+		return;
+	m_generation = generation;
+
+	// Everything queued or batched so far belongs to the old generation
+	m_queue.clear();
+	m_results.clear();
+	m_batchTimer.stop();
+}
+
+quint64 IconRenderer::generation() const {
+	return m_generation.load();
+}
+
+QList<int> IconRenderer::reprioritize(const std::function<int(int index)> &priorityForIndex) {
+	QList<int> cancelled;
+	for (auto &job : m_queue) {
+		job.priority = priorityForIndex(job.index);
+		if (job.priority < 0)
+			cancelled.append(job.index);
+	}
+	if (!cancelled.isEmpty()) {
+		m_queue.erase(std::remove_if(m_queue.begin(), m_queue.end(),
+									 [](const IconRenderJob &job) { return job.priority < 0; }),
+					  m_queue.end());
+	}
+	return cancelled;
+}
+
+QImage IconRenderer::renderSvg(const QByteArray &svg, int size, const QColor &background) {
+	QSvgRenderer renderer(svg);
+	if (!renderer.isValid())
+		return QImage();
+
+	QImage image(size, size, QImage::Format_ARGB32_Premultiplied);
+	image.fill(background);
+
+	QPainter painter(&image);
+	painter.setRenderHint(QPainter::Antialiasing);
+	painter.setRenderHint(QPainter::SmoothPixmapTransform);
+	renderer.render(&painter);
+	painter.end();
+
+	return image;
+}
+
+QImage IconRenderer::renderCached(const QByteArray &svg, int size, const QColor &background,
+								   const IconRenderKey &key) {
+	return cachedImage(svg, key, [&]() {
+		return renderSvg(svg, size, background);
+	});
+}
+
+QImage IconRenderer::renderCompiledCached(const CompiledIcon &icon, int size, const QColor &background,
+										   const IconRenderKey &key) {
+	return cachedImage(icon.paths, key, [&]() {
+		return renderCompiledIcon(icon, size, background);
+	});
+}
+
+QImage IconRenderer::cachedImage(const QByteArray &content, const IconRenderKey &key,
+								  const std::function<QImage()> &render) {
+	if (!key.isValid())
+		return render();
+
+	auto &diskCache = ThumbnailDiskCache::instance();
+	const QString fileKey = ThumbnailDiskCache::fileKey(key, content);
+	QImage image = diskCache.load(fileKey);
+	if (image.isNull()) {
+		image = render();
+		diskCache.store(fileKey, image);
+	}
+	return image;
+}
+
+void IconRenderer::dispatch() {
+	while (m_inFlight < m_pool.maxThreadCount() && !m_queue.empty()) {
+		// Lowest priority value first; min_element keeps FIFO order among equals
+		auto next = std::min_element(m_queue.begin(), m_queue.end(),
+									 [](const IconRenderJob &a, const IconRenderJob &b) {
+										 return a.priority < b.priority;
+									 });
+		IconRenderJob job = std::move(*next);
+		m_queue.erase(next);
+
+		++m_inFlight;
+		m_pool.start([this, job]() {
+			IconRenderResult result;
+			result.index = job.index;
+			result.key = job.key;
+			// Skip the parse entirely if the job went stale while waiting for a worker
+			if (job.generation == m_generation.load())
+				result.image = job.compiled.isNull()
+					? renderCached(job.svg, job.size, job.background, job.key)
+					: renderCompiledCached(job.compiled, job.size, job.background, job.key);
+
+			const quint64 generation = job.generation;
+			QMetaObject::invokeMethod(this, [this, generation, result]() {
+				onJobFinished(generation, result);
+			}, Qt::QueuedConnection);
+		});
+	}
+}
+
+void IconRenderer::onJobFinished(quint64 generation, const IconRenderResult &result) {
+	--m_inFlight;
+
+	if (generation == m_generation.load()) {
+		m_results.append(result);
+		if (!m_batchTimer.isActive())
+			m_batchTimer.start();
+	}
+
+	dispatch();
+}
+
+void IconRenderer::flushResults() {
+	if (m_results.isEmpty())
+		return;
+	QList<IconRenderResult> results;
+	results.swap(m_results);
+	emit iconsRendered(results);
+}
@@ -0,0 +1,93 @@
+#ifndef ICONRENDERER_H
+#define ICONRENDERER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QColor>
+#include <QImage>
+#include <QList>
+#include <QThreadPool>
+#include <QTimer>
+
+#include "thumbnailcache.h"
+#include "compiledpath.h"
+
+#include <atomic>
+#include <functional>
+#include <vector>
+
+// Thumbnail render request, prepared on the GUI thread
+struct IconRenderJob {
+	int index = -1;          // Icon index in the model (IconEntry::index)
+	quint64 generation = 0;  // Model state the job was prepared for
+	int priority = 0;        // Lower renders first (0 = visible)
+	QByteArray svg;          // Resolved SVG source (entities and stroke width applied)
+	CompiledIcon compiled;   // Rendered instead of svg when set
+	int size = 0;
+	QColor background;
+	IconRenderKey key;       // Disk cache key; invalid to bypass the cache
+};
+
+// Rendered thumbnail handed back to the GUI thread
+struct IconRenderResult {
+	int index = -1;
+	IconRenderKey key;       // Parameters the image was rendered with
+	QImage image;            // Null if the SVG could not be parsed
+};
+
+// Renders SVG thumbnails into QImage on a worker pool
+//
+// Jobs wait in a priority queue on the GUI thread and are handed to the pool
+// only when a worker is free, so the queue order can still change while the
+// user scrolls. Every job carries the model generation it was prepared for;
+// bumping the generation drops queued jobs and discards results of running
+// ones. Thumbnails found in the disk cache skip SVG parsing altogether, and
+// icons with a compiled path record are drawn without parsing any SVG.
+// Finished images are delivered in batches through iconsRendered(), so
+// the view repaints once per batch rather than once per icon.
+class IconRenderer : public QObject {
+	Q_OBJECT
+
+public:
+	explicit IconRenderer(QObject *parent = nullptr);
+	~IconRenderer() override;
+
+	void enqueue(const IconRenderJob &job);
+
+	void setGeneration(quint64 generation);
+	quint64 generation() const;
+
+	// Recomputes queued priorities; jobs mapped to a negative priority are
+	// cancelled and their icon indices returned
+	QList<int> reprioritize(const std::function<int(int index)> &priorityForIndex);
+
+	// Thread-safe; shared by the worker pool and synchronous callers
+	static QImage renderSvg(const QByteArray &svg, int size, const QColor &background);
+
+	// Disk cache lookup first, then renderSvg(); fresh renders are written back
+	static QImage renderCached(const QByteArray &svg, int size, const QColor &background,
+							   const IconRenderKey &key);
+
+	// Same for a compiled path record, rendered without QSvgRenderer
+	static QImage renderCompiledCached(const CompiledIcon &icon, int size, const QColor &background,
+									   const IconRenderKey &key);
+
+signals:
+	void iconsRendered(const QList<IconRenderResult> &results);
+
+private:
+	void dispatch();
+	void onJobFinished(quint64 generation, const IconRenderResult &result);
+	void flushResults();
+	static QImage cachedImage(const QByteArray &content, const IconRenderKey &key,
+							  const std::function<QImage()> &render);
+
+	QThreadPool m_pool;
+	QTimer m_batchTimer;
+	std::vector<IconRenderJob> m_queue;
+	int m_inFlight = 0;
+	QList<IconRenderResult> m_results;
+	std::atomic<quint64> m_generation { 0 };
+};
+
+#endif // ICONRENDERER_H
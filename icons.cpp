@@ -1,4 +1,6 @@
 #include "icons.h"
+#include "benchmark.h"
+#include "iconexport.h"
 #include "icongrid.h"
 #include "iconmodel.h"
 #include "ui_icons.h"
@@ -6,9 +8,12 @@
 #include <QApplication>
 #include <QClipboard>
 #include <QDebug>
+#include <QElapsedTimer>
 #include <QFileDialog>
+#include <QGuiApplication>
 #include <QMessageBox>
 #include <QSettings>
+#include <QTimer>
 
 // Stringify macros for build number
 #define STRINGIFY(x) #x
@@ -89,6 +94,9 @@
 #include "library/bitmap/lib_oxygen5_64.h"
 
 MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), m_ui(new Ui::MainWindow) {
+	QElapsedTimer startupTimer;
+	startupTimer.start();
+
 	m_ui->setupUi(this);
 
 	// Setup icon size action group
@@ -102,9 +110,13 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), m_ui(new Ui::Main
 	m_iconCountLabel = new QLabel(this);
 	statusBar()->addPermanentWidget(m_iconCountLabel);
 
+	qDebug() << "Startup: window setup" << startupTimer.elapsed() << "ms";
+
 	setupConnections();
 	registerBuiltinCollections();
+	qDebug() << "Startup: collections registered" << startupTimer.elapsed() << "ms";
 	loadCollections();
+	qDebug() << "Startup: first collection loaded" << startupTimer.elapsed() << "ms";
 }
 
 MainWindow::~MainWindow() = default;
@@ -129,7 +141,7 @@ void MainWindow::setupConnections() {
 	connect(m_ui->iconGrid->model(), &IconModel::filterChanged, this, &MainWindow::updateIconCount);
 }
 
-void MainWindow::registerBuiltinCollections() {
+void registerBuiltinCollections() {
 	auto &registry = IconCollectionRegistry::instance();
 
 	// Bootstrap Icons - single size 16
@@ -299,6 +311,7 @@ void MainWindow::loadCollections() {
 	for (const auto &coll : bitmapCollections) {
 		names.append(coll.displayName);
 	}
+	names.append(GlobalIconList::displayName());
 
 	// Set up the toolbar's collection dropdown
 	auto *toolbar = m_ui->iconGrid->findChild<IconToolBar *>();
@@ -346,21 +359,16 @@ void MainWindow::loadCollections() {
 		}
 	}
 
-	// Count total icons
+	// Count total icons from catalog metadata; no list is constructed
 	int totalIcons = 0;
 	for (const auto &coll : collections) {
-		auto *tempList = registry.createIconList(coll.id, IconStyle::Outline, coll.defaultSize());
-		if (tempList) {
-			totalIcons += tempList->getCount();
-			delete tempList;
-		}
+		int count = registry.iconCount(coll.id, IconStyle::Outline, coll.defaultSize());
+		if (count < 0 && coll.hasStyle(IconStyle::Filled))
+			count = registry.iconCount(coll.id, IconStyle::Filled, coll.defaultSize());
+		totalIcons += qMax(0, count);
 	}
 	for (const auto &coll : bitmapCollections) {
-		auto *tempList = registry.createBitmapList(coll.id, coll.defaultSize());
-		if (tempList) {
-			totalIcons += tempList->getCount();
-			delete tempList;
-		}
+		totalIcons += qMax(0, registry.bitmapIconCount(coll.id, coll.defaultSize()));
 	}
 
 	int totalCollections = collections.size() + bitmapCollections.size();
@@ -368,22 +376,26 @@ void MainWindow::loadCollections() {
 }
 
 void MainWindow::loadCurrentCollection() {
-	auto &registry = IconCollectionRegistry::instance();
+	if (m_isGlobalSearch) {
+		if (!m_globalList)
+			m_globalList.reset(new GlobalIconList());
+		m_currentList = m_globalList.get();
+		m_ui->iconGrid->setIconList(m_globalList.get());
+		return;
+	}
 
-	if (m_isBitmapCollection) {
-		auto *list = registry.createBitmapList(m_currentCollectionId, m_currentBitmapSize);
-		if (list) {
-			m_bitmapLists.push_back(std::unique_ptr<BitmapIconList>(list));
-			m_currentList = list;
-			m_ui->iconGrid->setIconList(list);
-		}
-	} else {
-		auto *list = registry.createIconList(m_currentCollectionId, m_currentStyle, m_currentSvgSize);
-		if (list) {
-			m_iconLists.push_back(std::unique_ptr<SVGIconList>(list));
-			m_currentList = list;
-			m_ui->iconGrid->setIconList(list);
-		}
+	IconListKey key;
+	key.collectionId = m_currentCollectionId;
+	key.style = m_currentStyle;
+	key.size = m_isBitmapCollection ? m_currentBitmapSize : m_currentSvgSize;
+	key.bitmap = m_isBitmapCollection;
+
+	IconList *list = m_listPool.acquire(key);
+	if (list) {
+		m_currentList = list;
+		m_ui->iconGrid->setIconList(list, key);
+		// The model no longer references older lists
+		m_listPool.trim();
 	}
 }
 
@@ -437,6 +449,28 @@ void MainWindow::updateAvailableStyles() {
 void MainWindow::onCollectionChanged(const QString &name) {
 	auto &registry = IconCollectionRegistry::instance();
 
+	// Search across all collections at once
+	m_isGlobalSearch = (name == GlobalIconList::displayName());
+	if (m_isGlobalSearch) {
+		m_currentCollectionId.clear();
+		m_isBitmapCollection = false;
+		m_currentStyle = IconStyle::Outline;
+		loadCurrentCollection();
+
+		auto *toolbar = m_ui->iconGrid->toolBar();
+		if (toolbar) {
+			toolbar->setBitmapMode(false);
+			toolbar->setStyles({ iconStyleToString(IconStyle::Outline) });
+			toolbar->setSvgSizes({});
+			toolbar->setTwoToneMode(false);
+			toolbar->setStrokeWidthVisible(false);
+		}
+		m_ui->iconGrid->preview()->setBitmapMode(false);
+		// Relative mode at 1x leaves every collection's own stroke widths untouched
+		m_ui->iconGrid->setStrokeMode(false);
+		return;
+	}
+
 	// Check if it's a bitmap collection first
 	for (const auto &coll : registry.bitmapCollections()) {
 		if (coll.displayName == name) {
@@ -686,6 +720,34 @@ void MainWindow::updateIconCount() {
 }
 
 int main(int argc, char *argv[]) {
+	QElapsedTimer startupTimer;
+	startupTimer.start();
+
+	// Headless batch export: no widgets, offscreen platform unless one is chosen
+	for (int i = 1; i < argc; ++i) {
+		if (qstrcmp(argv[i], "--export") == 0) {
+			if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+				qputenv("QT_QPA_PLATFORM", "offscreen");
+			QGuiApplication app(argc, argv);
+			app.setApplicationName("Icon Viewer");
+			app.setOrganizationName("KomSoft");
+			app.setApplicationVersion(QString("%1 (%2)").arg(APP_VERSION).arg(TOSTRING(APP_BUILD)));
+			return runExportCommand(app.arguments());
+		}
+		if (qstrcmp(argv[i], "--benchmark-render") == 0) {
+			if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+				qputenv("QT_QPA_PLATFORM", "offscreen");
+			QGuiApplication app(argc, argv);
+			registerBuiltinCollections();
+			return runRenderBenchmark(app.arguments());
+		}
+		if (qstrcmp(argv[i], "--benchmark-rewrite") == 0) {
+			QCoreApplication app(argc, argv);
+			registerBuiltinCollections();
+			return runRewriteBenchmark(app.arguments());
+		}
+	}
+
 	QApplication app(argc, argv);
 	app.setApplicationName("Icon Viewer");
 	app.setOrganizationName("KomSoft");
@@ -695,5 +757,10 @@ int main(int argc, char *argv[]) {
 	w.setWindowTitle(QString("Icon Viewer v%1 (%2)").arg(APP_VERSION).arg(TOSTRING(APP_BUILD)));
 	w.show();
 
+	// Runs once the first frame has been queued for painting
+	QTimer::singleShot(0, &w, [startupTimer]() {
+		qDebug() << "Startup: event loop running after" << startupTimer.elapsed() << "ms";
+	});
+
 	return app.exec();
 }
@@ -11,6 +11,8 @@
 
 #include "library/lib_svgiconlist.h"
 #include "iconmodel.h"
+#include "globaliconlist.h"
+#include "iconlistpool.h"
 
 namespace Ui {
 class MainWindow;
@@ -47,7 +49,6 @@ private slots:
 private:
 	void setupConnections();
 	void loadCollections();
-	void registerBuiltinCollections();
 	void loadCurrentCollection();
 	void updateAvailableStyles();
 
@@ -55,13 +56,14 @@ private:
 	QActionGroup *m_iconSizeGroup;
 	QLabel *m_iconCountLabel;
 
-	std::vector<std::unique_ptr<SVGIconList>> m_iconLists;
-	std::vector<std::unique_ptr<BitmapIconList>> m_bitmapLists;
+	IconListPool m_listPool;  // Recently used lists, reused on switch-back
+	std::unique_ptr<GlobalIconList> m_globalList;  // "All Libraries", built on first use
 	IconList *m_currentList = nullptr;
 
 	QString m_currentCollectionId;
 	IconStyle m_currentStyle = IconStyle::Outline;
 	bool m_isBitmapCollection = false;
+	bool m_isGlobalSearch = false;
 	int m_currentBitmapSize = 32;
 	int m_currentSvgSize = 24;
 
@@ -69,4 +71,8 @@ private:
 	QString m_selectedName;
 };
 
+// Registers the generated collections with IconCollectionRegistry; used by
+// the main window and the headless export
+void registerBuiltinCollections();
+
 #endif // ICONS_H
@@ -0,0 +1,117 @@
+#include "iconsearch.h"
+
+#include <algorithm>
+#include <iterator>
+
+// Separates fields so a term never matches across them
+static const QChar c_fieldSeparator(0x1f);
+
+quint64 IconSearchIndex::trigramKey(QStringView text, qsizetype pos) {
+	return (quint64(text[pos].unicode()) << 32)
+		| (quint64(text[pos + 1].unicode()) << 16)
+		| quint64(text[pos + 2].unicode());
+}
+
+void IconSearchIndex::build(const std::vector<IconSearchDocument> &documents) {
+	clear();
+	m_texts.reserve(documents.size());
+
+	std::vector<quint64> trigrams;
+	for (const auto &document : documents) {
+		QString text = document.name;
+		for (const QString &keyword : document.keywords)
+			text += c_fieldSeparator + keyword;
+		if (!document.category.isEmpty())
+			text += c_fieldSeparator + document.category;
+		text = text.toCaseFolded();
+
+		// Each document is posted once per distinct trigram; ids stay ascending
+		const int id = static_cast<int>(m_texts.size());
+		trigrams.clear();
+		for (qsizetype pos = 0; pos + 3 <= text.size(); ++pos)
+			trigrams.push_back(trigramKey(text, pos));
+		std::sort(trigrams.begin(), trigrams.end());
+		trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+		for (quint64 trigram : trigrams)
+			m_postings[trigram].push_back(id);
+
+		m_texts.push_back(text);
+	}
+}
+
+void IconSearchIndex::clear() {
+	m_texts.clear();
+	m_postings.clear();
+	m_lastQuery.clear();
+	m_lastResults.clear();
+}
+
+std::vector<int> IconSearchIndex::candidatesFor(QStringView term) const {
+	// Intersect the postings of all trigrams of the term, shortest list first
+	std::vector<const std::vector<int>*> lists;
+	for (qsizetype pos = 0; pos + 3 <= term.size(); ++pos) {
+		auto it = m_postings.constFind(trigramKey(term, pos));
+		if (it == m_postings.constEnd())
+			return std::vector<int>();
+		lists.push_back(&it.value());
+	}
+	std::sort(lists.begin(), lists.end(),
+			  [](const std::vector<int> *a, const std::vector<int> *b) { return a->size() < b->size(); });
+
+	std::vector<int> result = *lists.front();
+	std::vector<int> narrowed;
+	for (size_t i = 1; i < lists.size() && !result.empty(); ++i) {
+		narrowed.clear();
+		std::set_intersection(result.begin(), result.end(), lists[i]->begin(), lists[i]->end(),
+							  std::back_inserter(narrowed));
+		result.swap(narrowed);
+	}
+	return result;
+}
+
+bool IconSearchIndex::matches(int document, const QStringList &terms) const {
+	const QString &text = m_texts[document];
+	for (const QString &term : terms) {
+		if (!text.contains(term))
+			return false;
+	}
+	return true;
+}
+
+std::vector<int> IconSearchIndex::search(const QString &query) {
+	const QString folded = query.toCaseFolded().simplified();
+	const QStringList terms = folded.split(QLatin1Char(' '), Qt::SkipEmptyParts);
+
+	std::vector<int> results;
+	if (terms.isEmpty()) {
+		results.resize(m_texts.size());
+		for (size_t i = 0; i < results.size(); ++i)
+			results[i] = static_cast<int>(i);
+	} else {
+		// Extending the previous query can only narrow its results
+		std::vector<int> candidates;
+		if (!m_lastQuery.isEmpty() && folded.startsWith(m_lastQuery)) {
+			candidates = m_lastResults;
+		} else {
+			auto longest = std::max_element(terms.begin(), terms.end(),
+											[](const QString &a, const QString &b) { return a.size() < b.size(); });
+			if (longest->size() >= 3) {
+				candidates = candidatesFor(*longest);
+			} else {
+				candidates.resize(m_texts.size());
+				for (size_t i = 0; i < candidates.size(); ++i)
+					candidates[i] = static_cast<int>(i);
+			}
+		}
+
+		results.reserve(candidates.size());
+		for (int document : candidates) {
+			if (matches(document, terms))
+				results.push_back(document);
+		}
+	}
+
+	m_lastQuery = folded;
+	m_lastResults = results;
+	return results;
+}
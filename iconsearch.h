@@ -0,0 +1,48 @@
+#ifndef ICONSEARCH_H
+#define ICONSEARCH_H
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+
+#include <vector>
+
+// Searchable text of one icon
+struct IconSearchDocument {
+	QString name;
+	QStringList keywords;  // Tags, aliases
+	QString category;
+};
+
+// Trigram index over icon names, tags and categories
+//
+// A query is split on whitespace and every term must occur as a substring
+// (case-insensitive) in the icon's name, keywords or category. Terms of
+// three or more characters are answered from trigram postings and then
+// verified; shorter terms scan the candidate set. When a query extends the
+// previous one, only the previous results are re-checked, so each extra
+// keystroke narrows instead of rescanning.
+class IconSearchIndex {
+public:
+	void build(const std::vector<IconSearchDocument> &documents);
+	void clear();
+
+	int documentCount() const { return static_cast<int>(m_texts.size()); }
+
+	// Matching document ids in ascending order
+	std::vector<int> search(const QString &query);
+
+private:
+	static quint64 trigramKey(QStringView text, qsizetype pos);
+	std::vector<int> candidatesFor(QStringView term) const;
+	bool matches(int document, const QStringList &terms) const;
+
+	std::vector<QString> m_texts;  // Case-folded name, keywords and category
+	QHash<quint64, std::vector<int>> m_postings;
+
+	// Last query, for incremental refinement
+	QString m_lastQuery;
+	std::vector<int> m_lastResults;
+};
+
+#endif // ICONSEARCH_H
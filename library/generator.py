@@ -2,10 +2,14 @@
 
 import os
 import glob
+import hashlib
 import subprocess
+import sys
 import re
 import json
+import math
 import shutil
+import struct
 import zipfile
 import urllib.request
 from datetime import datetime
@@ -19,10 +23,15 @@ bootstrap_regular_library_template = '''/* Auto Generated by {generator} on {dat
 #include <stdexcept>
 
 #include "lib_svgiconlist.h"
+#include "lib_contentstore.h"
+#include "lib_nametable.h"
 
 extern const char *svg_bootstrap_style_{style}_size_{size}[];
+extern const IconNameTableData svg_bootstrap_style_{style}_size_{size}_names;
+extern const unsigned int svg_bootstrap_style_{style}_size_{size}_content[];
+extern const char *svg_bootstrap_style_{style}_size_{size}_scale[];
 
-class Bootstrap{Style}{size}IconList : public SVGIconList {{
+class Bootstrap{Style}{size}IconList : public SVGIconList, public CompiledPathSource, public SvgSourceParts, public IconNameSource {{
 
     static const int c_icon_count = {count};
     QColor m_fillColor = clNone;
@@ -33,29 +42,58 @@ public:
     QString getName(int index) const override {{
         if (index < 0 || index >= c_icon_count)
             throw std::out_of_range("Requested icon index is out of range");
-        return QString::fromUtf8(svg_bootstrap_style_{style}_size_{size}[index]);
+        return IconNameTable(svg_bootstrap_style_{style}_size_{size}_names).nameString(index);
     }}
 
+    const IconNameTableData &getNameTable() const override {{ return svg_bootstrap_style_{style}_size_{size}_names; }}
+
     QString getBody(int index) const override {{
         if (index < 0 || index >= c_icon_count)
             throw std::out_of_range("Requested icon index is out of range");
-        return qReadAll(QString(":/svg/content/svg_bootstrap_style={style}_size={size}@%1.svg").arg(index));
+        return contentStore().body(svg_bootstrap_style_{style}_size_{size}_content[index], svg_bootstrap_style_{style}_size_{size}_scale[index]);
     }}
 
     QString getSource(int index) const override {{
         if (index < 0 || index >= c_icon_count)
             throw std::out_of_range("Requested icon index is out of range");
+        return getSourceHeader() + getSourceBody(index) + QLatin1String("</svg>");
+    }}
+
+    QString getSourceHeader() const override {{
         QString color = (m_fillColor == clNone) ? "currentColor" : m_fillColor.name();
         return QString("<svg viewBox=\\"0 0 {size} {size}\\" xmlns=\\"http://www.w3.org/2000/svg\\" "
-                       "fill=\\"%1\\" stroke=\\"%1\\" stroke-width=\\"0.5\\" stroke-linejoin=\\"round\\">%2</svg>")
-            .arg(color, getBody(index));
+                       "fill=\\"%1\\" stroke=\\"%1\\" stroke-width=\\"0.5\\" stroke-linejoin=\\"round\\">").arg(color);
     }}
 
+    QString getSourceBody(int index) const override {{ return getBody(index); }}
+
     QColor getFillColor() const override {{ return m_fillColor; }}
     void setFillColor(QColor value) override {{ m_fillColor = value; }}
 
     QString getLibraryName() const override {{ return "Bootstrap Regular {size}"; }}
     int getBaseSize() const override {{ return {size}; }}
+
+    QByteArray getCompiledPaths(int index, const char **scale) const override {{
+        if (index < 0 || index >= c_icon_count)
+            return QByteArray();
+        *scale = svg_bootstrap_style_{style}_size_{size}_scale[index];
+        return pathStore().blob(svg_bootstrap_style_{style}_size_{size}_content[index]);
+    }}
+
+    CompiledPathStyle getCompiledStyle() const override {{
+        return {{ CompiledPathStyle::Current, CompiledPathStyle::Current, 0.5f, Qt::FlatCap, Qt::RoundJoin }};
+    }}
+
+private:
+    static IconContentStore &pathStore() {{
+        static IconContentStore &store = IconContentStore::shared(":/svg/content/svg_bootstrap.paths");
+        return store;
+    }}
+
+    static IconContentStore &contentStore() {{
+        static IconContentStore &store = IconContentStore::shared(":/svg/content/svg_bootstrap.pack", ":/svg/content/bootstrap.zdict");
+        return store;
+    }}
 }};
 
 #endif // LIB_BOOTSTRAP_{STYLE}_{size}_H
@@ -70,10 +108,15 @@ bootstrap_fill_library_template = '''/* Auto Generated by {generator} on {date}
 #include <stdexcept>
 
 #include "lib_svgiconlist.h"
+#include "lib_contentstore.h"
+#include "lib_nametable.h"
 
 extern const char *svg_bootstrap_style_{style}_size_{size}[];
+extern const IconNameTableData svg_bootstrap_style_{style}_size_{size}_names;
+extern const unsigned int svg_bootstrap_style_{style}_size_{size}_content[];
+extern const char *svg_bootstrap_style_{style}_size_{size}_scale[];
 
-class Bootstrap{Style}{size}IconList : public SVGIconList {{
+class Bootstrap{Style}{size}IconList : public SVGIconList, public CompiledPathSource, public SvgSourceParts, public IconNameSource {{
 
     static const int c_icon_count = {count};
     QColor m_fillColor = clNone;
@@ -84,32 +127,59 @@ public:
     QString getName(int index) const override {{
         if (index < 0 || index >= c_icon_count)
             throw std::out_of_range("Requested icon index is out of range");
-        return QString::fromUtf8(svg_bootstrap_style_{style}_size_{size}[index]);
+        return IconNameTable(svg_bootstrap_style_{style}_size_{size}_names).nameString(index);
     }}
 
+    const IconNameTableData &getNameTable() const override {{ return svg_bootstrap_style_{style}_size_{size}_names; }}
+
     QString getBody(int index) const override {{
         if (index < 0 || index >= c_icon_count)
             throw std::out_of_range("Requested icon index is out of range");
-        return qReadAll(QString(":/svg/content/svg_bootstrap_style={style}_size={size}@%1.svg").arg(index));
+        return contentStore().body(svg_bootstrap_style_{style}_size_{size}_content[index], svg_bootstrap_style_{style}_size_{size}_scale[index]);
     }}
 
     QString getSource(int index) const override {{
         if (index < 0 || index >= c_icon_count)
             throw std::out_of_range("Requested icon index is out of range");
+        return getSourceHeader() + getSourceBody(index) + QLatin1String("</svg>");
+    }}
+
+    QString getSourceHeader() const override {{
         QString sColor;
         if (m_fillColor != clNone)
             sColor = QString(" fill=\\"%1\\"").arg(m_fillColor.name());
-        return QString("<svg viewBox=\\"0 0 {size} {size}\\" xmlns=\\"http://www.w3.org/2000/svg\\"%1>")
-            .arg(sColor)
-            + getBody(index)
-            + QString("</svg>");
+        return QString("<svg viewBox=\\"0 0 {size} {size}\\" xmlns=\\"http://www.w3.org/2000/svg\\"%1>").arg(sColor);
     }}
 
+    QString getSourceBody(int index) const override {{ return getBody(index); }}
+
     QColor getFillColor() const override {{ return m_fillColor; }}
     void setFillColor(QColor value) override {{ m_fillColor = value; }}
 
     QString getLibraryName() const override {{ return "Bootstrap {Style} {size}"; }}
     int getBaseSize() const override {{ return {size}; }}
+
+    QByteArray getCompiledPaths(int index, const char **scale) const override {{
+        if (index < 0 || index >= c_icon_count)
+            return QByteArray();
+        *scale = svg_bootstrap_style_{style}_size_{size}_scale[index];
+        return pathStore().blob(svg_bootstrap_style_{style}_size_{size}_content[index]);
+    }}
+
+    CompiledPathStyle getCompiledStyle() const override {{
+        return {{ CompiledPathStyle::Current, CompiledPathStyle::None, -1.0f, Qt::FlatCap, Qt::MiterJoin }};
+    }}
+
+private:
+    static IconContentStore &pathStore() {{
+        static IconContentStore &store = IconContentStore::shared(":/svg/content/svg_bootstrap.paths");
+        return store;
+    }}
+
+    static IconContentStore &contentStore() {{
+        static IconContentStore &store = IconContentStore::shared(":/svg/content/svg_bootstrap.pack", ":/svg/content/bootstrap.zdict");
+        return store;
+    }}
 }};
 
 #endif // LIB_BOOTSTRAP_{STYLE}_{size}_H
@@ -124,12 +194,17 @@ tabler_outline_library_template = '''/* Auto Generated by {generator} on {date}
 #include <stdexcept>
 
 #include "lib_svgiconlist.h"
+#include "lib_contentstore.h"
+#include "lib_nametable.h"
 
 extern const char *svg_tabler_style_outline[];
+extern const IconNameTableData svg_tabler_style_outline_names;
+extern const unsigned int svg_tabler_style_outline_content[];
+extern const char *svg_tabler_style_outline_scale[];
 extern const char *svg_tabler_style_outline_tags[][16];
 extern const char *svg_tabler_style_outline_categories[];
 
-class TablerOutline{size}IconList : public SVGIconList {{
+class TablerOutline{size}IconList : public SVGIconList, public CompiledPathSource, public SvgSourceParts, public IconNameSource {{
 
     static const int c_icon_count = {count};
     QColor m_fillColor = clNone;
@@ -140,26 +215,32 @@ public:
     QString getName(int index) const override {{
         if (index < 0 || index >= c_icon_count)
             throw std::out_of_range("Requested icon index is out of range");
-        return QString::fromUtf8(svg_tabler_style_outline[index]);
+        return IconNameTable(svg_tabler_style_outline_names).nameString(index);
     }}
 
+    const IconNameTableData &getNameTable() const override {{ return svg_tabler_style_outline_names; }}
+
     QString getBody(int index) const override {{
         if (index < 0 || index >= c_icon_count)
             throw std::out_of_range("Requested icon index is out of range");
-        return qReadAll(QString(":/svg/content/svg_tabler_style=outline@%1.svg").arg(index));
+        return contentStore().body(svg_tabler_style_outline_content[index], svg_tabler_style_outline_scale[index]);
     }}
 
     QString getSource(int index) const override {{
         if (index < 0 || index >= c_icon_count)
             throw std::out_of_range("Requested icon index is out of range");
+        return getSourceHeader() + getSourceBody(index) + QLatin1String("</svg>");
+    }}
+
+    QString getSourceHeader() const override {{
         QString strokeColor = (m_fillColor == clNone) ? "currentColor" : m_fillColor.name();
-        QString body = getBody(index);
         return QString("<svg viewBox=\\"0 0 {size} {size}\\" xmlns=\\"http://www.w3.org/2000/svg\\" "
                        "fill=\\"none\\" stroke=\\"%1\\" stroke-width=\\"2\\" "
-                       "stroke-linecap=\\"round\\" stroke-linejoin=\\"round\\">%2</svg>")
-            .arg(strokeColor, body);
+                       "stroke-linecap=\\"round\\" stroke-linejoin=\\"round\\">").arg(strokeColor);
     }}
 
+    QString getSourceBody(int index) const override {{ return getBody(index); }}
+
     QColor getFillColor() const override {{ return m_fillColor; }}
     void setFillColor(QColor value) override {{ m_fillColor = value; }}
 
@@ -181,6 +262,28 @@ public:
             return QString();
         return QString::fromUtf8(svg_tabler_style_outline_categories[index]);
     }}
+
+    QByteArray getCompiledPaths(int index, const char **scale) const override {{
+        if (index < 0 || index >= c_icon_count)
+            return QByteArray();
+        *scale = svg_tabler_style_outline_scale[index];
+        return pathStore().blob(svg_tabler_style_outline_content[index]);
+    }}
+
+    CompiledPathStyle getCompiledStyle() const override {{
+        return {{ CompiledPathStyle::None, CompiledPathStyle::Current, 2.0f, Qt::RoundCap, Qt::RoundJoin }};
+    }}
+
+private:
+    static IconContentStore &pathStore() {{
+        static IconContentStore &store = IconContentStore::shared(":/svg/content/svg_tabler.paths");
+        return store;
+    }}
+
+    static IconContentStore &contentStore() {{
+        static IconContentStore &store = IconContentStore::shared(":/svg/content/svg_tabler.pack", ":/svg/content/tabler.zdict");
+        return store;
+    }}
 }};
 
 #endif // LIB_TABLER_OUTLINE_{size}_H
@@ -195,12 +298,17 @@ tabler_filled_library_template = '''/* Auto Generated by {generator} on {date} *
 #include <stdexcept>
 
 #include "lib_svgiconlist.h"
+#include "lib_contentstore.h"
+#include "lib_nametable.h"
 
 extern const char *svg_tabler_style_filled[];
+extern const IconNameTableData svg_tabler_style_filled_names;
+extern const unsigned int svg_tabler_style_filled_content[];
+extern const char *svg_tabler_style_filled_scale[];
 extern const char *svg_tabler_style_filled_tags[][16];
 extern const char *svg_tabler_style_filled_categories[];
 
-class TablerFilled{size}IconList : public SVGIconList {{
+class TablerFilled{size}IconList : public SVGIconList, public CompiledPathSource, public SvgSourceParts, public IconNameSource {{
 
     static const int c_icon_count = {count};
     QColor m_fillColor = clNone;
@@ -211,25 +319,31 @@ public:
     QString getName(int index) const override {{
         if (index < 0 || index >= c_icon_count)
             throw std::out_of_range("Requested icon index is out of range");
-        return QString::fromUtf8(svg_tabler_style_filled[index]);
+        return IconNameTable(svg_tabler_style_filled_names).nameString(index);
     }}
 
+    const IconNameTableData &getNameTable() const override {{ return svg_tabler_style_filled_names; }}
+
     QString getBody(int index) const override {{
         if (index < 0 || index >= c_icon_count)
             throw std::out_of_range("Requested icon index is out of range");
-        return qReadAll(QString(":/svg/content/svg_tabler_style=filled@%1.svg").arg(index));
+        return contentStore().body(svg_tabler_style_filled_content[index], svg_tabler_style_filled_scale[index]);
     }}
 
     QString getSource(int index) const override {{
         if (index < 0 || index >= c_icon_count)
             throw std::out_of_range("Requested icon index is out of range");
+        return getSourceHeader() + getSourceBody(index) + QLatin1String("</svg>");
+    }}
+
+    QString getSourceHeader() const override {{
         QString fillColor = (m_fillColor == clNone) ? "currentColor" : m_fillColor.name();
-        QString body = getBody(index);
         return QString("<svg viewBox=\\"0 0 {size} {size}\\" xmlns=\\"http://www.w3.org/2000/svg\\" "
-                       "fill=\\"%1\\">%2</svg>")
-            .arg(fillColor, body);
+                       "fill=\\"%1\\">").arg(fillColor);
     }}
 
+    QString getSourceBody(int index) const override {{ return getBody(index); }}
+
     QColor getFillColor() const override {{ return m_fillColor; }}
     void setFillColor(QColor value) override {{ m_fillColor = value; }}
 
@@ -251,6 +365,28 @@ public:
             return QString();
         return QString::fromUtf8(svg_tabler_style_filled_categories[index]);
     }}
+
+    QByteArray getCompiledPaths(int index, const char **scale) const override {{
+        if (index < 0 || index >= c_icon_count)
+            return QByteArray();
+        *scale = svg_tabler_style_filled_scale[index];
+        return pathStore().blob(svg_tabler_style_filled_content[index]);
+    }}
+
+    CompiledPathStyle getCompiledStyle() const override {{
+        return {{ CompiledPathStyle::Current, CompiledPathStyle::None, -1.0f, Qt::FlatCap, Qt::MiterJoin }};
+    }}
+
+private:
+    static IconContentStore &pathStore() {{
+        static IconContentStore &store = IconContentStore::shared(":/svg/content/svg_tabler.paths");
+        return store;
+    }}
+
+    static IconContentStore &contentStore() {{
+        static IconContentStore &store = IconContentStore::shared(":/svg/content/svg_tabler.pack", ":/svg/content/tabler.zdict");
+        return store;
+    }}
 }};
 
 #endif // LIB_TABLER_FILLED_{size}_H
@@ -265,10 +401,15 @@ fluent_outline_library_template = '''/* Auto Generated by {generator} on {date}
 #include <stdexcept>
 
 #include "lib_svgiconlist.h"
+#include "lib_contentstore.h"
+#include "lib_nametable.h"
 
 extern const char *svg_fluent_style_{style}_size_{size}[];
+extern const IconNameTableData svg_fluent_style_{style}_size_{size}_names;
+extern const unsigned int svg_fluent_style_{style}_size_{size}_content[];
+extern const char *svg_fluent_style_{style}_size_{size}_scale[];
 
-class Fluent{Style}{size}IconList : public SVGIconList {{
+class Fluent{Style}{size}IconList : public SVGIconList, public CompiledPathSource, public SvgSourceParts, public IconNameSource {{
 
     static const int c_icon_count = {count};
     QColor m_fillColor = clNone;
@@ -279,23 +420,32 @@ public:
     QString getName(int index) const override {{
         if (index < 0 || index >= c_icon_count)
             throw std::out_of_range("Requested icon index is out of range");
-        return QString::fromUtf8(svg_fluent_style_{style}_size_{size}[index]);
+        return IconNameTable(svg_fluent_style_{style}_size_{size}_names).nameString(index);
     }}
 
+    const IconNameTableData &getNameTable() const override {{ return svg_fluent_style_{style}_size_{size}_names; }}
+
     QString getBody(int index) const override {{
         if (index < 0 || index >= c_icon_count)
             throw std::out_of_range("Requested icon index is out of range");
-        return qReadAll(QString(":/svg/content/svg_fluent_style={style}_size={size}@%1.svg").arg(index));
+        return contentStore().body(svg_fluent_style_{style}_size_{size}_content[index], svg_fluent_style_{style}_size_{size}_scale[index]);
     }}
 
     QString getSource(int index) const override {{
         if (index < 0 || index >= c_icon_count)
             throw std::out_of_range("Requested icon index is out of range");
+        return getSourceHeader() + getSourceBody(index) + QLatin1String("</svg>");
+    }}
+
+    QString getSourceHeader() const override {{
         QString color = (m_fillColor == clNone) ? "currentColor" : m_fillColor.name();
-        QString body = getBody(index).replace(" fill=\\"#212121\\"", "");
         return QString("<svg viewBox=\\"0 0 {size} {size}\\" xmlns=\\"http://www.w3.org/2000/svg\\" "
-                       "fill=\\"%1\\" stroke=\\"%1\\" stroke-width=\\"0.5\\" stroke-linejoin=\\"round\\">%2</svg>")
-            .arg(color, body);
+                       "fill=\\"%1\\" stroke=\\"%1\\" stroke-width=\\"0.5\\" stroke-linejoin=\\"round\\">").arg(color);
+    }}
+
+    // The source's #212121 placeholder fill gives way to the list's color
+    QString getSourceBody(int index) const override {{
+        return getBody(index).replace(" fill=\\"#212121\\"", "");
     }}
 
     QColor getFillColor() const override {{ return m_fillColor; }}
@@ -303,6 +453,28 @@ public:
 
     QString getLibraryName() const override {{ return "Fluent {Style} {size}"; }}
     int getBaseSize() const override {{ return {size}; }}
+
+    QByteArray getCompiledPaths(int index, const char **scale) const override {{
+        if (index < 0 || index >= c_icon_count)
+            return QByteArray();
+        *scale = svg_fluent_style_{style}_size_{size}_scale[index];
+        return pathStore().blob(svg_fluent_style_{style}_size_{size}_content[index]);
+    }}
+
+    CompiledPathStyle getCompiledStyle() const override {{
+        return {{ CompiledPathStyle::Current, CompiledPathStyle::Current, 0.5f, Qt::FlatCap, Qt::RoundJoin }};
+    }}
+
+private:
+    static IconContentStore &pathStore() {{
+        static IconContentStore &store = IconContentStore::shared(":/svg/content/svg_fluent.paths");
+        return store;
+    }}
+
+    static IconContentStore &contentStore() {{
+        static IconContentStore &store = IconContentStore::shared(":/svg/content/svg_fluent.pack", ":/svg/content/fluent.zdict");
+        return store;
+    }}
 }};
 
 #endif // LIB_FLUENT_{STYLE}_{size}_H
@@ -317,10 +489,15 @@ fluent_filled_library_template = '''/* Auto Generated by {generator} on {date} *
 #include <stdexcept>
 
 #include "lib_svgiconlist.h"
+#include "lib_contentstore.h"
+#include "lib_nametable.h"
 
 extern const char *svg_fluent_style_{style}_size_{size}[];
+extern const IconNameTableData svg_fluent_style_{style}_size_{size}_names;
+extern const unsigned int svg_fluent_style_{style}_size_{size}_content[];
+extern const char *svg_fluent_style_{style}_size_{size}_scale[];
 
-class Fluent{Style}{size}IconList : public SVGIconList {{
+class Fluent{Style}{size}IconList : public SVGIconList, public CompiledPathSource, public SvgSourceParts, public IconNameSource {{
 
     static const int c_icon_count = {count};
     QColor m_fillColor = clNone;
@@ -331,22 +508,31 @@ public:
     QString getName(int index) const override {{
         if (index < 0 || index >= c_icon_count)
             throw std::out_of_range("Requested icon index is out of range");
-        return QString::fromUtf8(svg_fluent_style_{style}_size_{size}[index]);
+        return IconNameTable(svg_fluent_style_{style}_size_{size}_names).nameString(index);
     }}
 
+    const IconNameTableData &getNameTable() const override {{ return svg_fluent_style_{style}_size_{size}_names; }}
+
     QString getBody(int index) const override {{
         if (index < 0 || index >= c_icon_count)
             throw std::out_of_range("Requested icon index is out of range");
-        return qReadAll(QString(":/svg/content/svg_fluent_style={style}_size={size}@%1.svg").arg(index));
+        return contentStore().body(svg_fluent_style_{style}_size_{size}_content[index], svg_fluent_style_{style}_size_{size}_scale[index]);
     }}
 
     QString getSource(int index) const override {{
         if (index < 0 || index >= c_icon_count)
             throw std::out_of_range("Requested icon index is out of range");
+        return getSourceHeader() + getSourceBody(index) + QLatin1String("</svg>");
+    }}
+
+    QString getSourceHeader() const override {{
+        return QString("<svg viewBox=\\"0 0 {size} {size}\\" xmlns=\\"http://www.w3.org/2000/svg\\">");
+    }}
+
+    // The source's #212121 placeholder fill becomes the list's color
+    QString getSourceBody(int index) const override {{
         QString fillAttr = (m_fillColor == clNone) ? "" : QString(" fill=\\"%1\\"").arg(m_fillColor.name());
-        return QString("<svg viewBox=\\"0 0 {size} {size}\\" xmlns=\\"http://www.w3.org/2000/svg\\">")
-            + getBody(index).replace(" fill=\\"#212121\\"", fillAttr)
-            + QString("</svg>");
+        return getBody(index).replace(" fill=\\"#212121\\"", fillAttr);
     }}
 
     QColor getFillColor() const override {{ return m_fillColor; }}
@@ -354,6 +540,28 @@ public:
 
     QString getLibraryName() const override {{ return "Fluent {Style} {size}"; }}
     int getBaseSize() const override {{ return {size}; }}
+
+    QByteArray getCompiledPaths(int index, const char **scale) const override {{
+        if (index < 0 || index >= c_icon_count)
+            return QByteArray();
+        *scale = svg_fluent_style_{style}_size_{size}_scale[index];
+        return pathStore().blob(svg_fluent_style_{style}_size_{size}_content[index]);
+    }}
+
+    CompiledPathStyle getCompiledStyle() const override {{
+        return {{ CompiledPathStyle::Current, CompiledPathStyle::None, -1.0f, Qt::FlatCap, Qt::MiterJoin }};
+    }}
+
+private:
+    static IconContentStore &pathStore() {{
+        static IconContentStore &store = IconContentStore::shared(":/svg/content/svg_fluent.paths");
+        return store;
+    }}
+
+    static IconContentStore &contentStore() {{
+        static IconContentStore &store = IconContentStore::shared(":/svg/content/svg_fluent.pack", ":/svg/content/fluent.zdict");
+        return store;
+    }}
 }};
 
 #endif // LIB_FLUENT_{STYLE}_{size}_H
@@ -368,10 +576,15 @@ breeze_library_template = '''/* Auto Generated by {generator} on {date} */
 #include <stdexcept>
 
 #include "lib_svgiconlist.h"
+#include "lib_contentstore.h"
+#include "lib_nametable.h"
 
 extern const char *svg_breeze_size_{size}_group_{group}[];
+extern const IconNameTableData svg_breeze_size_{size}_group_{group}_names;
+extern const unsigned int svg_breeze_size_{size}_group_{group}_content[];
+extern const char *svg_breeze_size_{size}_group_{group}_scale[];
 
-class Breeze{Group}{size}IconList : public SVGIconList {{
+class Breeze{Group}{size}IconList : public SVGIconList, public IconNameSource {{
 
     static const int c_icon_count = {count};
     QColor m_fillColor = clNone;
@@ -382,13 +595,15 @@ public:
     QString getName(int index) const override {{
         if (index < 0 || index >= c_icon_count)
             throw std::out_of_range("Requested icon index is out of range");
-        return QString::fromUtf8(svg_breeze_size_{size}_group_{group}[index]);
+        return IconNameTable(svg_breeze_size_{size}_group_{group}_names).nameString(index);
     }}
 
+    const IconNameTableData &getNameTable() const override {{ return svg_breeze_size_{size}_group_{group}_names; }}
+
     QString getBody(int index) const override {{
         if (index < 0 || index >= c_icon_count)
             throw std::out_of_range("Requested icon index is out of range");
-        return qReadAll(QString(":/svg/content/svg_breeze_size={size}_group={group}@%1.svg").arg(index));
+        return contentStore().body(svg_breeze_size_{size}_group_{group}_content[index], svg_breeze_size_{size}_group_{group}_scale[index]);
     }}
 
     QString getSource(int index) const override {{
@@ -407,6 +622,12 @@ public:
 
     QString getLibraryName() const override {{ return "Breeze {Group} {size}"; }}
     int getBaseSize() const override {{ return {size}; }}
+
+private:
+    static IconContentStore &contentStore() {{
+        static IconContentStore &store = IconContentStore::shared(":/svg/content/svg_breeze.pack", ":/svg/content/breeze.zdict");
+        return store;
+    }}
 }};
 
 #endif // LIB_BREEZE_{GROUP}_{size}_H
@@ -424,12 +645,14 @@ oxygen_library_template = '''/* Auto Generated by {generator} on {date} */
 #include <stdexcept>
 
 #include "../lib_svgiconlist.h"
+#include "../lib_nametable.h"
 
 extern const char *png_{collection}_size_{size}[];
+extern const IconNameTableData png_{collection}_size_{size}_names;
 extern const char *png_{collection}_size_{size}_aliases[][2];
 extern const int png_{collection}_size_{size}_alias_count;
 
-class {Collection}{size}IconList : public BitmapIconList {{
+class {Collection}{size}IconList : public BitmapIconList, public IconNameSource {{
     static const int c_icon_count = {count};
     bool m_grayscale = false;
     static bool s_rccLoaded;
@@ -442,9 +665,11 @@ public:
     QString getName(int index) const override {{
         if (index < 0 || index >= c_icon_count)
             throw std::out_of_range("Requested icon index is out of range");
-        return QString::fromUtf8(png_{collection}_size_{size}[index]);
+        return IconNameTable(png_{collection}_size_{size}_names).nameString(index);
     }}
 
+    const IconNameTableData &getNameTable() const override {{ return png_{collection}_size_{size}_names; }}
+
     QPixmap getPixmap(int index) const override {{
         if (index < 0 || index >= c_icon_count)
             throw std::out_of_range("Requested icon index is out of range");
@@ -502,6 +727,133 @@ inline bool {Collection}{size}IconList::s_rccLoaded = false;
 '''
 
 
+catalog_header = '''/* Auto Generated by {generator} on {date} */
+
+#ifndef LIB_CATALOG_H
+#define LIB_CATALOG_H
+
+#include "lib_nametable.h"
+
+/* One entry per generated icon list; lets the application enumerate icon
+   names, tags and categories without instantiating any list class */
+typedef struct IconCatalogEntry {{
+    const char *collection;          /* Registry id, e.g. "tabler", "breeze-actions" */
+    const char *style;               /* "Outline", "Filled", "Light" or "Color" for bitmaps */
+    int size;
+    int count;
+    int bitmap;                      /* Non-zero for PNG collections */
+    const char **names;
+    const IconNameTableData *name_table;
+    const char *(*tags)[16];         /* NULL if the collection has no tags */
+    const char **categories;         /* NULL if the collection has no categories */
+}} IconCatalogEntry;
+
+/* Outline and filled icon that make up one TwoTone icon */
+typedef struct IconTwoTonePair {{
+    int outline;
+    int filled;
+}} IconTwoTonePair;
+
+/* Precomputed TwoTone pairing of a collection's Outline and Filled lists
+   at one size, in outline order */
+typedef struct IconTwoToneEntry {{
+    const char *collection;
+    int size;
+    int outline_count;               /* Counts of the lists the pairs were built from */
+    int filled_count;
+    int count;
+    const IconTwoTonePair *pairs;
+}} IconTwoToneEntry;
+
+#ifdef __cplusplus
+extern "C" {{
+#endif
+
+extern const IconCatalogEntry icon_catalog[];
+extern const int icon_catalog_count;
+
+extern const IconTwoToneEntry icon_twotone_catalog[];
+extern const int icon_twotone_catalog_count;
+
+#ifdef __cplusplus
+}}
+#endif
+
+#endif // LIB_CATALOG_H
+'''
+
+
+def catalog_entry(collection, style, size, names, names_var, tags_var=None, categories_var=None, bitmap=False):
+    return {'collection': collection, 'style': style, 'size': size, 'count': len(names), 'bitmap': bitmap,
+            'names': names_var, 'name_list': names, 'tags': tags_var, 'categories': categories_var}
+
+
+def twotone_pairs(outline_names: list, filled_names: list) -> list:
+    """Outline/filled index pairs in outline order; the lowercased outline name matches
+    name_key() of the filled name and the last filled duplicate wins."""
+    filled_by_key = {}
+    for index, name in enumerate(filled_names):
+        filled_by_key[tuple(name_key(name))] = index
+    return [(index, filled_by_key[key]) for index, key in
+            ((i, tuple(utf16_units(ascii_lower(n)))) for i, n in enumerate(outline_names)) if key in filled_by_key]
+
+
+def catalog_style(style: str) -> str:
+    """Map generator style names to the application's IconStyle names."""
+    return {'regular': 'Outline', 'outline': 'Outline', 'fill': 'Filled', 'filled': 'Filled'}.get(style.lower(), style.title())
+
+
+def save_catalog(entries: list):
+    """Write lib_catalog.h/.c describing every generated icon list."""
+    save_svg_iconlist(catalog_header, "lib_catalog",
+                      {'generator': os.path.basename(__file__), 'date': datetime.today().strftime('%Y-%m-%d %H:%M:%S')})
+    with open("lib_catalog.c", 'w') as file:
+        file.write('#include <stddef.h>\n\n')
+        file.write('#include "lib_catalog.h"\n\n')
+        for e in entries:
+            file.write(f'extern const char *{e["names"]}[];\n')
+            file.write(f'extern const IconNameTableData {e["names"]}_names;\n')
+            if e['tags']:
+                file.write(f'extern const char *{e["tags"]}[][16];\n')
+            if e['categories']:
+                file.write(f'extern const char *{e["categories"]}[];\n')
+        file.write('\nconst IconCatalogEntry icon_catalog[] = {\n')
+        for e in entries:
+            tags = e['tags'] or 'NULL'
+            categories = e['categories'] or 'NULL'
+            file.write(f'    {{"{e["collection"]}", "{e["style"]}", {e["size"]}, {e["count"]}, {1 if e["bitmap"] else 0}, '
+                       f'{e["names"]}, &{e["names"]}_names, {tags}, {categories}}},\n')
+        file.write('};\n\n')
+        file.write(f'const int icon_catalog_count = {len(entries)};\n\n')
+
+        # TwoTone pairs for every collection and size with both Outline and Filled lists
+        twotone = []
+        for outline in entries:
+            if outline['style'] != 'Outline' or outline['bitmap']:
+                continue
+            filled = next((e for e in entries if e['collection'] == outline['collection']
+                           and e['size'] == outline['size'] and e['style'] == 'Filled'), None)
+            if not filled:
+                continue
+            var = f'{outline["names"]}_twotone_pairs'
+            pairs = twotone_pairs(outline['name_list'], filled['name_list'])
+            file.write(f'static const IconTwoTonePair {var}[] = {{\n')
+            for outline_index, filled_index in pairs:
+                file.write(f'    {{{outline_index}, {filled_index}}},\n')
+            file.write('    {0, 0}\n')
+            file.write('};\n\n')
+            twotone.append((outline, filled, var, len(pairs)))
+
+        file.write('const IconTwoToneEntry icon_twotone_catalog[] = {\n')
+        for outline, filled, var, count in twotone:
+            file.write(f'    {{"{outline["collection"]}", {outline["size"]}, {outline["count"]}, {filled["count"]}, '
+                       f'{count}, {var}}},\n')
+        file.write('    {NULL, 0, 0, 0, 0, NULL}\n')
+        file.write('};\n\n')
+        file.write(f'const int icon_twotone_catalog_count = {len(twotone)};\n')
+    return ["lib_catalog.c"]
+
+
 def download_file(url, dest_path):
     """Download a file from URL if it doesn't exist."""
     if os.path.exists(dest_path):
@@ -691,17 +1043,571 @@ def extract_svg_content(svg_file, expected_size=None):
     return content
 
 
-def save_output(var: str, output_file_base: str, svg_contents, svg_basenames):
-    for idx, content in enumerate(svg_contents):
-        with open(f"content/{output_file_base}@{idx}.svg", 'w') as file:
-            file.write(content)
+# ----------------------------------------------------------------------------
+# Path compiler: SVG bodies to binary path records (see compiledpath.h)
+# ----------------------------------------------------------------------------
+
+class UnsupportedSvg(Exception):
+    """Raised for bodies that use features the compiled path format lacks."""
+
+
+PATH_CMD_MOVE, PATH_CMD_LINE, PATH_CMD_CUBIC, PATH_CMD_QUAD, PATH_CMD_CLOSE = range(5)
+PAINT_INHERIT, PAINT_NONE, PAINT_CURRENT, PAINT_RGBA = range(4)
+CAP_VALUES = {'butt': 1, 'round': 2, 'square': 3}
+JOIN_VALUES = {'miter': 1, 'round': 2, 'bevel': 3}
+
+SHAPE_ATTRIBUTES = {'d', 'cx', 'cy', 'r', 'rx', 'ry', 'x', 'y', 'width', 'height',
+                    'x1', 'y1', 'x2', 'y2', 'points'}
+STYLE_ATTRIBUTES = {'fill', 'stroke', 'stroke-width', 'fill-rule', 'stroke-linecap',
+                    'stroke-linejoin', 'transform'}
+IGNORED_ATTRIBUTES = {'id', 'data-name', 'clip-rule'}
+SHAPE_ELEMENTS = {'path', 'circle', 'ellipse', 'rect', 'line', 'polyline', 'polygon'}
+
+number_pattern = re.compile(r'[-+]?(?:\d+\.?\d*|\.\d+)(?:[eE][-+]?\d+)?')
+
+
+def parse_number(value):
+    value = (value or '0').strip()
+    if value.endswith('px'):
+        value = value[:-2]
+    if not number_pattern.fullmatch(value):
+        raise UnsupportedSvg(f"length {value}")
+    return float(value)
+
+
+def multiply_transform(a, b):
+    """a * b for SVG matrices (a b c d e f): b is applied first."""
+    return (a[0] * b[0] + a[2] * b[1], a[1] * b[0] + a[3] * b[1],
+            a[0] * b[2] + a[2] * b[3], a[1] * b[2] + a[3] * b[3],
+            a[0] * b[4] + a[2] * b[5] + a[4], a[1] * b[4] + a[3] * b[5] + a[5])
+
+
+def parse_transform(value):
+    result = (1.0, 0.0, 0.0, 1.0, 0.0, 0.0)
+    for name, args in re.findall(r'(\w+)\s*\(([^)]*)\)', value):
+        v = [float(n) for n in number_pattern.findall(args)]
+        if name == 'matrix' and len(v) == 6:
+            m = tuple(v)
+        elif name == 'translate' and len(v) in (1, 2):
+            m = (1, 0, 0, 1, v[0], v[1] if len(v) > 1 else 0)
+        elif name == 'scale' and len(v) in (1, 2):
+            m = (v[0], 0, 0, v[1] if len(v) > 1 else v[0], 0, 0)
+        elif name == 'rotate' and len(v) in (1, 3):
+            a = math.radians(v[0])
+            m = (math.cos(a), math.sin(a), -math.sin(a), math.cos(a), 0, 0)
+            if len(v) == 3:
+                m = multiply_transform(multiply_transform((1, 0, 0, 1, v[1], v[2]), m), (1, 0, 0, 1, -v[1], -v[2]))
+        elif name == 'skewX' and len(v) == 1:
+            m = (1, 0, math.tan(math.radians(v[0])), 1, 0, 0)
+        elif name == 'skewY' and len(v) == 1:
+            m = (1, math.tan(math.radians(v[0])), 0, 1, 0, 0)
+        else:
+            raise UnsupportedSvg(f"transform {name}")
+        result = multiply_transform(result, m)
+    return result
+
+
+def arc_to_cubics(x1, y1, rx, ry, angle, large_arc, sweep, x2, y2):
+    """SVG elliptical arc to cubic segments (endpoint parameterization, SVG 1.1 F.6)."""
+    if (x1, y1) == (x2, y2):
+        return []
+    rx, ry = abs(rx), abs(ry)
+    if rx == 0 or ry == 0:
+        return [(x1, y1, x2, y2, x2, y2)]
+    phi = math.radians(angle % 360)
+    cos_phi, sin_phi = math.cos(phi), math.sin(phi)
+    dx, dy = (x1 - x2) / 2, (y1 - y2) / 2
+    x1p = cos_phi * dx + sin_phi * dy
+    y1p = -sin_phi * dx + cos_phi * dy
+    lam = (x1p * x1p) / (rx * rx) + (y1p * y1p) / (ry * ry)
+    if lam > 1:
+        rx, ry = rx * math.sqrt(lam), ry * math.sqrt(lam)
+    num = rx * rx * ry * ry - rx * rx * y1p * y1p - ry * ry * x1p * x1p
+    den = rx * rx * y1p * y1p + ry * ry * x1p * x1p
+    coef = math.sqrt(max(0.0, num / den)) if den else 0.0
+    if large_arc == sweep:
+        coef = -coef
+    cxp, cyp = coef * rx * y1p / ry, -coef * ry * x1p / rx
+    cx = cos_phi * cxp - sin_phi * cyp + (x1 + x2) / 2
+    cy = sin_phi * cxp + cos_phi * cyp + (y1 + y2) / 2
+
+    def vector_angle(ux, uy, vx, vy):
+        a = math.atan2(ux * vy - uy * vx, ux * vx + uy * vy)
+        return a
+
+    theta1 = vector_angle(1, 0, (x1p - cxp) / rx, (y1p - cyp) / ry)
+    delta = vector_angle((x1p - cxp) / rx, (y1p - cyp) / ry, (-x1p - cxp) / rx, (-y1p - cyp) / ry)
+    if not sweep and delta > 0:
+        delta -= 2 * math.pi
+    elif sweep and delta < 0:
+        delta += 2 * math.pi
+
+    segments = max(1, int(math.ceil(abs(delta) / (math.pi / 2) - 1e-9)))
+    step = delta / segments
+    k = 4 / 3 * math.tan(step / 4)
+    result = []
+    theta = theta1
+    for _ in range(segments):
+        c1, s1 = math.cos(theta), math.sin(theta)
+        c2, s2 = math.cos(theta + step), math.sin(theta + step)
+        p1 = (c1 - k * s1, s1 + k * c1)
+        p2 = (c2 + k * s2, s2 - k * c2)
+        p3 = (c2, s2)
+        points = []
+        for px, py in (p1, p2, p3):
+            px, py = px * rx, py * ry
+            points += [cos_phi * px - sin_phi * py + cx, sin_phi * px + cos_phi * py + cy]
+        result.append(tuple(points))
+        theta += step
+    # Land exactly on the end point
+    last = list(result[-1])
+    last[4], last[5] = x2, y2
+    result[-1] = tuple(last)
+    return result
+
+
+def parse_path_data(d):
+    """Path data to absolute (commands, coordinates) using M, L, C, Q and Z only."""
+    tokens = re.findall(r'[MmLlHhVvCcSsQqTtAaZz]|[-+]?(?:\d+\.?\d*|\.\d+)(?:[eE][-+]?\d+)?', d)
+    if re.sub(r'[MmLlHhVvCcSsQqTtAaZz]|[-+]?(?:\d+\.?\d*|\.\d+)(?:[eE][-+]?\d+)?|[\s,]', '', d):
+        raise UnsupportedSvg("path data")
+    commands, coords = [], []
+    pos = 0
+    x = y = start_x = start_y = 0.0
+    last_control = None
+    last_cmd = ''
+    cmd = None
+
+    def number():
+        nonlocal pos
+        if pos >= len(tokens) or tokens[pos].isalpha():
+            raise UnsupportedSvg("path data")
+        pos += 1
+        return float(tokens[pos - 1])
+
+    def flag():
+        # Arc flags may be written without separators ("a1 1 0 01 2 2")
+        nonlocal pos
+        token = tokens[pos]
+        if token[0] in '01' and not token.isalpha():
+            if len(token) > 1:
+                tokens[pos] = token[1:]
+            else:
+                pos += 1
+            return token[0] == '1'
+        raise UnsupportedSvg("arc flag")
+
+    while pos < len(tokens):
+        if tokens[pos].isalpha():
+            cmd = tokens[pos]
+            pos += 1
+        elif cmd is None:
+            raise UnsupportedSvg("path data")
+        elif cmd in 'Mm':
+            cmd = 'L' if cmd == 'M' else 'l'  # Implicit lineto after moveto
+        relative = cmd.islower()
+        op = cmd.upper()
+        ox, oy = (x, y) if relative else (0.0, 0.0)
+        control = None
+        if op == 'Z':
+            commands.append(PATH_CMD_CLOSE)
+            x, y = start_x, start_y
+        elif op == 'M':
+            x, y = number() + ox, number() + oy
+            start_x, start_y = x, y
+            commands.append(PATH_CMD_MOVE)
+            coords += [x, y]
+        elif op in 'LHV':
+            if op == 'L':
+                x, y = number() + ox, number() + oy
+            elif op == 'H':
+                x = number() + ox
+            else:
+                y = number() + oy
+            commands.append(PATH_CMD_LINE)
+            coords += [x, y]
+        elif op in 'CS':
+            if op == 'C':
+                c1 = (number() + ox, number() + oy)
+            else:
+                c1 = (2 * x - last_control[0], 2 * y - last_control[1]) \
+                    if last_control and last_cmd in 'CS' else (x, y)
+            c2 = (number() + ox, number() + oy)
+            x, y = number() + ox, number() + oy
+            commands.append(PATH_CMD_CUBIC)
+            coords += [c1[0], c1[1], c2[0], c2[1], x, y]
+            control = c2
+        elif op in 'QT':
+            if op == 'Q':
+                c1 = (number() + ox, number() + oy)
+            else:
+                c1 = (2 * x - last_control[0], 2 * y - last_control[1]) \
+                    if last_control and last_cmd in 'QT' else (x, y)
+            x, y = number() + ox, number() + oy
+            commands.append(PATH_CMD_QUAD)
+            coords += [c1[0], c1[1], x, y]
+            control = c1
+        elif op == 'A':
+            rx, ry, angle = number(), number(), number()
+            large_arc, sweep = flag(), flag()
+            x2, y2 = number() + ox, number() + oy
+            for segment in arc_to_cubics(x, y, rx, ry, angle, large_arc, sweep, x2, y2):
+                commands.append(PATH_CMD_CUBIC)
+                coords += list(segment)
+            x, y = x2, y2
+        last_control = control
+        last_cmd = op
+        if op == 'Z' and pos < len(tokens) and not tokens[pos].isalpha():
+            raise UnsupportedSvg("path data")
+    return commands, coords
+
+
+def shape_to_path(tag, attrs):
+    if tag == 'path':
+        return parse_path_data(attrs.get('d', ''))
+    if tag in ('circle', 'ellipse'):
+        cx, cy = parse_number(attrs.get('cx')), parse_number(attrs.get('cy'))
+        if tag == 'circle':
+            rx = ry = parse_number(attrs.get('r'))
+        else:
+            rx, ry = parse_number(attrs.get('rx')), parse_number(attrs.get('ry'))
+        if rx <= 0 or ry <= 0:
+            return [], []
+        d = f"M{cx + rx} {cy}A{rx} {ry} 0 1 1 {cx - rx} {cy}A{rx} {ry} 0 1 1 {cx + rx} {cy}Z"
+        return parse_path_data(d)
+    if tag == 'rect':
+        x, y = parse_number(attrs.get('x')), parse_number(attrs.get('y'))
+        w, h = parse_number(attrs.get('width')), parse_number(attrs.get('height'))
+        if w <= 0 or h <= 0:
+            return [], []
+        rx, ry = attrs.get('rx'), attrs.get('ry')
+        rx = parse_number(rx) if rx is not None else None
+        ry = parse_number(ry) if ry is not None else None
+        rx = ry if rx is None else rx
+        ry = rx if ry is None else ry
+        rx, ry = min(rx or 0, w / 2), min(ry or 0, h / 2)
+        if rx <= 0 or ry <= 0:
+            return parse_path_data(f"M{x} {y}H{x + w}V{y + h}H{x}Z")
+        return parse_path_data(f"M{x + rx} {y}H{x + w - rx}A{rx} {ry} 0 0 1 {x + w} {y + ry}"
+                               f"V{y + h - ry}A{rx} {ry} 0 0 1 {x + w - rx} {y + h}"
+                               f"H{x + rx}A{rx} {ry} 0 0 1 {x} {y + h - ry}"
+                               f"V{y + ry}A{rx} {ry} 0 0 1 {x + rx} {y}Z")
+    if tag == 'line':
+        return parse_path_data(f"M{parse_number(attrs.get('x1'))} {parse_number(attrs.get('y1'))}"
+                               f"L{parse_number(attrs.get('x2'))} {parse_number(attrs.get('y2'))}")
+    if tag in ('polyline', 'polygon'):
+        points = number_pattern.findall(attrs.get('points', ''))
+        if len(points) < 4 or len(points) % 2:
+            return [], []
+        d = "M" + " ".join(points)
+        return parse_path_data(d + ("Z" if tag == 'polygon' else ""))
+    raise UnsupportedSvg(tag)
+
+
+def parse_paint(value, inherit_fills=()):
+    value = value.strip()
+    if value == 'none':
+        return PAINT_NONE, 0
+    if value == 'currentColor':
+        return PAINT_CURRENT, 0
+    if value.lower() in inherit_fills:
+        return PAINT_INHERIT, 0
+    m = re.fullmatch(r'#([0-9a-fA-F]{3}|[0-9a-fA-F]{6})', value)
+    if not m:
+        raise UnsupportedSvg(f"paint {value}")
+    hex_value = m.group(1)
+    if len(hex_value) == 3:
+        hex_value = ''.join(c * 2 for c in hex_value)
+    return PAINT_RGBA, 0xff000000 | int(hex_value, 16)
+
+
+def compile_svg_paths(body: str, inherit_fills=()):
+    """Compile an SVG body into a path record, or return b'' if unsupported.
+
+    Record (little endian): u16 shape count, then per shape: u8 fill paint,
+    u8 stroke paint, u8 flags (bit 0 even-odd, bit 1 stroke width set,
+    bits 2-3 cap, bits 4-5 join; 0 = inherit), u8 reserved, [u32 fill rgba],
+    [u32 stroke rgba], [f32 stroke width], f32 transform[6], u32 command
+    count, u32 coordinate count, u8 commands padded to 4 bytes, f32 coords.
+    """
+    import xml.etree.ElementTree as ElementTree
+
+    if '<!--' in body or '&' in body:
+        return b''
+    try:
+        root = ElementTree.fromstring(f'<svg xmlns="http://www.w3.org/2000/svg">{body}</svg>')
+    except ElementTree.ParseError:
+        return b''
+
+    shapes = []
+
+    def visit(element, inherited):
+        for child in element:
+            tag = child.tag.split('}')[-1]
+            if tag not in SHAPE_ELEMENTS and tag != 'g':
+                raise UnsupportedSvg(tag)
+            style = dict(inherited)
+            for name, value in child.attrib.items():
+                if name in IGNORED_ATTRIBUTES or (tag != 'g' and name in SHAPE_ATTRIBUTES):
+                    continue
+                if name not in STYLE_ATTRIBUTES:
+                    raise UnsupportedSvg(name)
+                if name == 'transform':
+                    style['transform'] = multiply_transform(style['transform'], parse_transform(value))
+                elif name == 'fill':
+                    style['fill'] = parse_paint(value, inherit_fills)
+                elif name == 'stroke':
+                    style['stroke'] = parse_paint(value)
+                elif name == 'stroke-width':
+                    style['stroke-width'] = parse_number(value)
+                elif name == 'fill-rule':
+                    style['evenodd'] = value.strip() == 'evenodd'
+                elif name == 'stroke-linecap':
+                    style['cap'] = CAP_VALUES.get(value.strip(), 0)
+                elif name == 'stroke-linejoin':
+                    if value.strip() not in JOIN_VALUES:
+                        raise UnsupportedSvg(f"linejoin {value}")
+                    style['join'] = JOIN_VALUES[value.strip()]
+            if tag == 'g':
+                visit(child, style)
+                continue
+            commands, coords = shape_to_path(tag, child.attrib)
+            if commands:
+                shapes.append((style, commands, coords))
+
+    initial = {'transform': (1.0, 0.0, 0.0, 1.0, 0.0, 0.0), 'fill': (PAINT_INHERIT, 0),
+               'stroke': (PAINT_INHERIT, 0), 'stroke-width': None, 'evenodd': False, 'cap': 0, 'join': 0}
+    try:
+        visit(root, initial)
+    except (UnsupportedSvg, ValueError, IndexError, TypeError):
+        return b''
+    if not shapes or len(shapes) > 0xffff:
+        return b''
+
+    record = bytearray(struct.pack('<H', len(shapes)))
+    for style, commands, coords in shapes:
+        fill, fill_rgba = style['fill']
+        stroke, stroke_rgba = style['stroke']
+        flags = (1 if style['evenodd'] else 0) | (2 if style['stroke-width'] is not None else 0) \
+            | (style['cap'] << 2) | (style['join'] << 4)
+        record += struct.pack('<BBBB', fill, stroke, flags, 0)
+        if fill == PAINT_RGBA:
+            record += struct.pack('<I', fill_rgba)
+        if stroke == PAINT_RGBA:
+            record += struct.pack('<I', stroke_rgba)
+        if style['stroke-width'] is not None:
+            record += struct.pack('<f', style['stroke-width'])
+        record += struct.pack('<6f', *style['transform'])
+        record += struct.pack('<II', len(commands), len(coords))
+        record += bytes(commands) + b'\0' * (-len(commands) % 4)
+        record += struct.pack(f'<{len(coords)}f', *coords)
+    return bytes(record)
+
+
+class ContentStore:
+    """Content-addressed SVG bodies of one library, shared by all its lists.
+
+    Identical bodies are stored once. The scale() wrapper that
+    extract_svg_content adds for mismatched viewBoxes is split off first, so
+    a body that only differs in that wrapper is shared too; the scale is kept
+    per icon and re-applied at runtime.
+    """
+    scaled_body = re.compile(r'^((?:<!-- ENTITIES:.*? -->\n)?)<g transform="scale\(([^)]*)\)">(.*)</g>$', re.DOTALL)
+
+    def __init__(self, compile_paths=False, inherit_fills=()):
+        self.bodies = []
+        self.paths = []
+        self.ids = {}
+        self.references = 0
+        # Path records for the C++ fast path (compiledpath.h); fills listed in
+        # inherit_fills are ones getSource() strips or replaces
+        self.compile_paths = compile_paths
+        self.inherit_fills = inherit_fills
+
+    def add(self, content: str):
+        """Returns (body id, scale string or None)."""
+        scale = None
+        match = self.scaled_body.match(content)
+        if match:
+            content = match.group(1) + match.group(3)
+            scale = match.group(2)
+        body = content.encode('utf-8')
+        key = hashlib.sha1(body).digest()
+        if key not in self.ids:
+            self.ids[key] = len(self.bodies)
+            self.bodies.append(body)
+            if self.compile_paths:
+                self.paths.append(compile_svg_paths(content, self.inherit_fills))
+        self.references += 1
+        return self.ids[key], scale
+
+    @staticmethod
+    def write_pack(path: str, entries):
+        """Write entries as a plain (version 1) pack.
+
+        Layout (little endian): b"ICPK", u32 version, u32 count,
+        u32 offsets[count + 1] relative to the entries, entries back to
+        back. Read by IconContentStore (lib_contentstore.h).
+        """
+        offsets = [0]
+        for entry in entries:
+            offsets.append(offsets[-1] + len(entry))
+        with open(path, 'wb') as file:
+            file.write(b'ICPK')
+            file.write(struct.pack('<II', 1, len(entries)))
+            file.write(struct.pack(f'<{len(offsets)}I', *offsets))
+            for entry in entries:
+                file.write(entry)
+        return offsets[-1]
+
+    def save(self, path: str):
+        """Write the unique bodies to path, and their path records next to it (.paths).
+
+        Returns the files written.
+        """
+        files = [path]
+        size = self.write_pack(path, self.bodies)
+        print(f"  {path}: {self.references} icons, {len(self.bodies)} unique bodies, {size} bytes")
+        if self.compile_paths:
+            paths_file = os.path.splitext(path)[0] + ".paths"
+            size = self.write_pack(paths_file, self.paths)
+            compiled = sum(1 for record in self.paths if record)
+            print(f"  {paths_file}: {compiled} of {len(self.paths)} bodies compiled, {size} bytes")
+            files.append(paths_file)
+        return files
+
+
+def compress_library_pack(library: str, dict_size: int = 64 * 1024, level: int = 19):
+    """Rewrite the pack of one library as version 2: zstd frames against a shared dictionary.
+
+    The dictionary is trained on all unique bodies of the library and written
+    to content/<library>.zdict. If training fails no .zdict is written, and the
+    bodies become plain zstd frames the application decodes without one.
+    Prints the sizes so the effect on the binary can be compared with the
+    plain pack. Returns the dictionary file, or None if none was written.
+    """
+    import zstandard
+
+    path = f"content/svg_{library}.pack"
+    with open(path, 'rb') as file:
+        data = file.read()
+    assert data[:4] == b'ICPK' and struct.unpack('<I', data[4:8])[0] == 1, path
+    count = struct.unpack('<I', data[8:12])[0]
+    offsets = struct.unpack(f'<{count + 1}I', data[12:12 + (count + 1) * 4])
+    base = 12 + (count + 1) * 4
+    bodies = [data[base + offsets[i]:base + offsets[i + 1]] for i in range(count)]
+
+    samples = [body for body in bodies if body]
+    if not samples:
+        return None
+    plain_size = sum(len(body) for body in samples)
+    try:
+        dictionary = zstandard.train_dictionary(dict_size, samples, level=level)
+        dict_data = dictionary.as_bytes()
+    except zstandard.ZstdError as e:
+        print(f"  {library}: dictionary training failed ({e}), compressing without dictionary")
+        dictionary = None
+        dict_data = b''
+    dict_file = None
+    if dict_data:
+        dict_file = f"content/{library}.zdict"
+        with open(dict_file, 'wb') as file:
+            file.write(dict_data)
+
+    compressor = zstandard.ZstdCompressor(level=level, dict_data=dictionary, write_content_size=True)
+    frames = [compressor.compress(body) for body in bodies]
+    offsets = [0]
+    for frame in frames:
+        offsets.append(offsets[-1] + len(frame))
+    with open(path, 'wb') as file:
+        file.write(b'ICPK')
+        file.write(struct.pack('<II', 2, len(frames)))
+        file.write(struct.pack(f'<{len(offsets)}I', *offsets))
+        for frame in frames:
+            file.write(frame)
+    compressed_size = len(dict_data) + offsets[-1] + len(offsets) * 4
+    print(f"  {library}: {plain_size} bytes of SVG bodies -> {compressed_size} bytes "
+          f"({100.0 * compressed_size / plain_size:.1f}%, dictionary {len(dict_data)} bytes)")
+    return dict_file
+
+
+def ascii_lower(text: str) -> str:
+    return ''.join(c.lower() if 'A' <= c <= 'Z' else c for c in text)
+
+
+def utf16_units(text: str) -> list:
+    data = text.encode('utf-16-le')
+    return list(struct.unpack(f'<{len(data) // 2}H', data))
+
+
+def name_hash(name: str) -> int:
+    """FNV-1a over the ASCII-lowercased UTF-16 units, as IconNameTable::hashName."""
+    h = 0x811c9dc5
+    for unit in utf16_units(ascii_lower(name)):
+        h = ((h ^ unit) * 0x01000193) & 0xffffffff
+    return h
+
+
+def name_key(name: str) -> list:
+    """Matching key of a filled icon as UTF-16 units: ASCII-lowercased, without a "-fill" suffix."""
+    if name.endswith('-fill'):
+        name = name[:-5]
+    return utf16_units(ascii_lower(name))
+
+
+def write_c_array(file, c_type: str, var: str, values: list, per_line: int = 16):
+    file.write(f'static const {c_type} {var}[] = {{\n')
+    # Trailing sentinel keeps empty lists valid C
+    values = list(values) + [0]
+    for i in range(0, len(values), per_line):
+        file.write('    ' + ', '.join(str(v) for v in values[i:i + per_line]) + ',\n')
+    file.write('};\n\n')
+
+
+def write_name_table(file, var: str, names: list):
+    """Write <var>_names, an IconNameTableData over one UTF-16 pool (see lib_nametable.h)."""
+    pool, offsets, lengths = [], [], []
+    for name in names:
+        units = utf16_units(name)
+        if len(units) > 0xffff:
+            raise ValueError(f"Icon name too long: {name[:40]}...")
+        offsets.append(len(pool))
+        lengths.append(len(units))
+        pool.extend(units)
+
+    write_c_array(file, 'unsigned short', f'{var}_name_pool', pool)
+    write_c_array(file, 'unsigned int', f'{var}_name_offsets', offsets)
+    write_c_array(file, 'unsigned short', f'{var}_name_lengths', lengths)
+    write_c_array(file, 'unsigned int', f'{var}_name_hashes', [f'0x{name_hash(n):08x}u' for n in names], 8)
+    file.write(f'const IconNameTableData {var}_names = {{\n')
+    file.write(f'    {var}_name_pool, {var}_name_offsets, {var}_name_lengths,\n')
+    file.write(f'    {var}_name_hashes, {len(names)}\n')
+    file.write('};\n\n')
+
+
+def save_output(var: str, output_file_base: str, svg_contents, svg_basenames, store: ContentStore):
+    content = [store.add(svg_content) for svg_content in svg_contents]
 
     with open(f"{output_file_base}.c", 'w') as file:
         file.write('#include <stddef.h>\n\n')
+        file.write('#include "lib_nametable.h"\n\n')
         file.write('const char* %s[] = {\n' % var)
         for basename in svg_basenames:
             file.write(f'    "{basename}",\n')
         file.write('    NULL\n')
+        file.write('};\n\n')
+        write_name_table(file, var, svg_basenames)
+
+        # Body id in the library's content store, and scale() wrapper if any
+        file.write('const unsigned int %s_content[] = {\n' % var)
+        for body_id, _ in content:
+            file.write(f'    {body_id},\n')
+        file.write('    0\n')
+        file.write('};\n\n')
+        file.write('const char* %s_scale[] = {\n' % var)
+        for _, scale in content:
+            file.write(f'    "{scale}",\n' if scale else '    NULL,\n')
+        file.write('    NULL\n')
         file.write('};\n')
 
     return [f"{output_file_base}.c"]
@@ -728,7 +1634,7 @@ def main_bootstrap():
     repo_dir = "." + library
     icon_folder = os.path.join(repo_dir, "icons")
 
-    meta = {'library': library, 'output': [], 'sizes': [16], 'styles': ['regular', 'fill']}
+    meta = {'library': library, 'output': [], 'catalog': [], 'content': ContentStore(compile_paths=True), 'sizes': [16], 'styles': ['regular', 'fill']}
     pull_git_repository(repo_url, repo_dir)
     svg_all_files = scan_for_svg_files(icon_folder)
     for size in meta['sizes']:
@@ -746,7 +1652,8 @@ def main_bootstrap():
             svg_basenames = [os.path.splitext(os.path.basename(svg_file))[0] for svg_file in svg_files]
             output_var_base = get_output_var_base(library, style=style, size=size)
             output_file_base = get_output_file_base(library, style=style, size=size)
-            meta['output'].extend(save_output(output_var_base, output_file_base, svg_contents, svg_basenames))
+            meta['output'].extend(save_output(output_var_base, output_file_base, svg_contents, svg_basenames, meta['content']))
+            meta['catalog'].append(catalog_entry(library, catalog_style(style), size, svg_basenames, output_var_base))
 
             # Use outline template (with stroke) for regular style, fill template for fill style
             template = bootstrap_regular_library_template if style == 'regular' else bootstrap_fill_library_template
@@ -766,7 +1673,7 @@ def main_tabler():
     repo_dir = "." + library
     pull_git_repository(repo_url, repo_dir)
 
-    meta = {'library': library, 'output': [], 'sizes': [24], 'styles': ["filled", "outline"]}
+    meta = {'library': library, 'output': [], 'catalog': [], 'content': ContentStore(compile_paths=True), 'sizes': [24], 'styles': ["filled", "outline"]}
     for size in meta['sizes']:
         for style in meta['styles']:
             icon_folder = os.path.join(repo_dir, "icons", style)
@@ -782,11 +1689,13 @@ def main_tabler():
             # Extract metadata for each icon
             svg_metadata = [extract_tabler_metadata(svg_file) for svg_file in svg_files]
 
-            meta['output'].extend(save_output(output_var_base, output_file_base, svg_contents, svg_basenames))
+            meta['output'].extend(save_output(output_var_base, output_file_base, svg_contents, svg_basenames, meta['content']))
 
             # Save metadata to C file
             save_tabler_metadata(output_var_base, output_file_base, svg_metadata)
             meta['output'].append(f"{output_file_base}_meta.c")
+            meta['catalog'].append(catalog_entry(library, catalog_style(style), size, svg_basenames, output_var_base,
+                                                 f"{output_var_base}_tags", f"{output_var_base}_categories"))
 
             # Use different templates for outline vs filled
             template = tabler_outline_library_template if style == "outline" else tabler_filled_library_template
@@ -859,7 +1768,7 @@ def main_fluent():
 
     pull_git_repository(repo_url, repo_dir)
 
-    meta = {'library': library, 'output': [], 'sizes': [], 'styles': []}
+    meta = {'library': library, 'output': [], 'catalog': [], 'content': ContentStore(compile_paths=True, inherit_fills=('#212121',)), 'sizes': [], 'styles': []}
     for root, dirs, files in os.walk(assets_folder):
         sizes = []
         styles = []
@@ -899,7 +1808,8 @@ def main_fluent():
                 output_file_base = get_output_file_base(library, style=style.lower(), size=size)
                 output_var_base = get_output_var_base(library, style=style.lower(), size=size)
                 svg_contents = [extract_svg_content(svg_file, expected_size=size) for svg_file in svg_files]
-                meta['output'].extend(save_output(output_var_base, output_file_base, svg_contents, svg_basenames))
+                meta['output'].extend(save_output(output_var_base, output_file_base, svg_contents, svg_basenames, meta['content']))
+                meta['catalog'].append(catalog_entry(library, catalog_style(style), size, svg_basenames, output_var_base))
 
                 # Generate header file for this size/style combination
                 # Use outline template (with stroke) for regular/light styles, filled template for filled style
@@ -925,7 +1835,7 @@ def main_breeze():
     pull_git_repository(repo_url, repo_dir)
 
     assets_folder = os.path.join(repo_dir, "icons")
-    meta = {'library': library, 'output': [], 'sizes': [12, 16, 22, 32, 48, 64], 'styles': []}
+    meta = {'library': library, 'output': [], 'catalog': [], 'content': ContentStore(), 'sizes': [12, 16, 22, 32, 48, 64], 'styles': []}
 
     for root, dirs, files in os.walk(assets_folder):
         for dir in dirs:
@@ -940,7 +1850,8 @@ def main_breeze():
                     svg_files.sort(key=lambda f: os.path.basename(f).lower())
                     svg_contents = [extract_svg_content(svg_file, expected_size=size) for svg_file in svg_files]
                     svg_basenames = [os.path.splitext(os.path.basename(svg_file))[0] for svg_file in svg_files]
-                    meta['output'].extend(save_output(output_var_base, output_file_base, svg_contents, svg_basenames))
+                    meta['output'].extend(save_output(output_var_base, output_file_base, svg_contents, svg_basenames, meta['content']))
+                    meta['catalog'].append(catalog_entry(f"{library}-{group}", "Outline", size, svg_basenames, output_var_base))
 
                     # Generate header file for this group/size combination
                     save_svg_iconlist(breeze_library_template,
@@ -1036,7 +1947,7 @@ def process_oxygen_collection(bitmap_dir, collection_name, display_name, source_
                   'emotes', 'mimetypes', 'places', 'status']
 
     rcc_tool = find_rcc_tool()
-    meta = {'collection': collection_name, 'output': [], 'sizes': [], 'rcc_file': None}
+    meta = {'collection': collection_name, 'output': [], 'catalog': [], 'sizes': [], 'rcc_file': None}
 
     # Collect all icons from all sizes for the combined QRC
     all_qrc_entries = []
@@ -1089,11 +2000,13 @@ def process_oxygen_collection(bitmap_dir, collection_name, display_name, source_
         c_file = os.path.join(bitmap_dir, f"png_{collection_name}_size_{size}.c")
         with open(c_file, 'w') as f:
             f.write('#include <stddef.h>\n\n')
+            f.write('#include "../lib_nametable.h"\n\n')
             f.write(f'const char* png_{collection_name}_size_{size}[] = {{\n')
             for name in png_names:
                 f.write(f'    "{name}",\n')
             f.write('    NULL\n')
             f.write('};\n\n')
+            write_name_table(f, f'png_{collection_name}_size_{size}', png_names)
 
             # Write alias data
             f.write(f'const char* png_{collection_name}_size_{size}_aliases[][2] = {{\n')
@@ -1103,6 +2016,8 @@ def process_oxygen_collection(bitmap_dir, collection_name, display_name, source_
             f.write('};\n\n')
             f.write(f'const int png_{collection_name}_size_{size}_alias_count = {len(all_aliases)};\n')
         meta['output'].append(c_file)
+        meta['catalog'].append(catalog_entry(collection_name, "Color", size, png_names,
+                                             f"png_{collection_name}_size_{size}", bitmap=True))
 
         print(f"    Found {len(all_aliases)} aliases")
 
@@ -1176,7 +2091,7 @@ def main_oxygen():
         }
     ]
 
-    all_meta = {'library': 'oxygen', 'output': [], 'sizes': [], 'rcc_files': [], 'collections': []}
+    all_meta = {'library': 'oxygen', 'output': [], 'catalog': [], 'sizes': [], 'rcc_files': [], 'collections': []}
 
     for coll in collections:
         meta = process_oxygen_collection(
@@ -1189,6 +2104,7 @@ def main_oxygen():
         if meta:
             all_meta['collections'].append(meta)
             all_meta['output'].extend(meta['output'])
+            all_meta['catalog'].extend(meta['catalog'])
             if meta['rcc_file']:
                 all_meta['rcc_files'].append(meta['rcc_file'])
             # Merge sizes
@@ -1201,6 +2117,10 @@ def main_oxygen():
 
 
 if __name__ == "__main__":
+    # --zstd: compress SVG bodies with a per-library dictionary (needs the
+    # zstandard module here and libzstd for the application)
+    use_zstd = "--zstd" in sys.argv[1:]
+
     # cleanup before generation
     print("Cleanup ...")
     content = 'content'
@@ -1217,8 +2137,29 @@ if __name__ == "__main__":
 
     # Process bitmap collections (Oxygen icons)
     bitmap_output = main_oxygen()
+
+    # Resources are listed explicitly, so files left in content/ by older
+    # generator runs (e.g. per-list packs) are never embedded
+    content_files = []
+    for m in output:
+        content_files += m['content'].save(f"content/svg_{m['library']}.pack")
+
+    if use_zstd:
+        print("Compressing SVG bodies ...")
+        for m in output:
+            dict_file = compress_library_pack(m['library'])
+            if dict_file:
+                content_files.append(dict_file)
+
+    # Catalog of all generated lists (names, tags, categories) for global search
+    catalog = [e for m in output for e in m['catalog']] + bitmap_output['catalog']
+    catalog_files = save_catalog(catalog)
+
     with open("library.pri", 'w') as file:
         file.write("RESOURCES += library/library.qrc \n")
+        if use_zstd:
+            file.write("DEFINES += ICONS_ZSTD\n")
+            file.write("LIBS += -lzstd\n")
         file.write("SOURCES += \\\n")
         for m in output:
             for f in m['output']:
@@ -1226,11 +2167,14 @@ if __name__ == "__main__":
         # Add bitmap C files
         for f in bitmap_output['output']:
             file.write(f"    library/{f}\\\n")
+        for f in catalog_files:
+            file.write(f"    library/{f}\\\n")
         file.write("\n")
     with open("library.qrc", 'w') as file:
         file.write('<RCC>\n')
         file.write('<qresource prefix="/svg">\n')
-        for f in glob.glob(f"{content}/*.svg"):
-            file.write(f"  <file>{f}</file>" + "\n")
+        # Packs are read in place, so they must not be compressed
+        for f in sorted(content_files):
+            file.write(f'  <file compression-algorithm="none">{f}</file>' + "\n")
         file.write('</qresource>\n')
         file.write('</RCC>\n')
@@ -0,0 +1,265 @@
+#ifndef LIB_CONTENTSTORE_H
+#define LIB_CONTENTSTORE_H
+
+#include <QByteArray>
+#include <QCache>
+#include <QDebug>
+#include <QMutex>
+#include <QResource>
+#include <QString>
+#include <QtEndian>
+#include <Qt>
+#include <map>
+#include <memory>
+#include <stdexcept>
+
+#ifdef ICONS_ZSTD
+#include <zstd.h>
+#endif
+
+// SVG bodies of one library, packed into a single resource
+//
+// generator.py stores every distinct body once; each generated list maps its
+// icon indexes to body ids (and an optional scale() wrapper), so identical
+// bodies across sizes and styles share one entry.
+//
+// Layout written by generator.py (integers little endian):
+//   "ICPK"  u32 version  u32 count  u32 offsets[count + 1]  bodies
+// Offsets are relative to the start of the bodies, which are stored back to
+// back. The pack is listed with compression-algorithm="none" in library.qrc,
+// so the resource data is used in place.
+//
+// Version 1 bodies are plain UTF-8: lookups are O(1) and copy nothing until
+// the caller converts a body to QString. Version 2 bodies are zstd frames
+// compressed against a dictionary shared by the whole library (generator.py
+// --zstd, builds with ICONS_ZSTD); only requested bodies are decoded and the
+// results are kept in a small cache.
+class IconContentStore {
+public:
+    static const quint32 c_magic = 0x4b504349;  // "ICPK"
+    static const quint32 c_versionPlain = 1;
+    static const quint32 c_versionZstd = 2;
+
+    explicit IconContentStore(const QString &path, const QString &dictionaryPath = QString())
+        : m_decoded(1024 * 1024) {
+        m_data = resourceData(path, m_copy, &m_size);
+        if (!m_data) {
+            qWarning() << "Content pack not found:" << path;
+            return;
+        }
+
+        if (m_size < 12 || qFromLittleEndian<quint32>(m_data) != c_magic) {
+            qWarning() << "Invalid content pack:" << path;
+            m_data = nullptr;
+            return;
+        }
+        m_version = qFromLittleEndian<quint32>(m_data + 4);
+        if (m_version != c_versionPlain && m_version != c_versionZstd) {
+            qWarning() << "Unsupported content pack version" << m_version << path;
+            m_data = nullptr;
+            return;
+        }
+        const quint32 count = qFromLittleEndian<quint32>(m_data + 8);
+        const qint64 tableEnd = 12 + (qint64(count) + 1) * 4;
+        if (tableEnd > m_size
+            || tableEnd + qFromLittleEndian<quint32>(m_data + 12 + qint64(count) * 4) > m_size) {
+            qWarning() << "Truncated content pack:" << path;
+            m_data = nullptr;
+            return;
+        }
+        m_offsets = m_data + 12;
+        m_bodies = m_data + tableEnd;
+        m_count = static_cast<int>(count);
+
+        if (m_version == c_versionZstd) {
+#ifdef ICONS_ZSTD
+            m_dctx = ZSTD_createDCtx();
+            // A library whose dictionary could not be trained has no .zdict
+            // and plain zstd frames
+            qint64 dictionarySize = 0;
+            const uchar *dictionary = dictionaryPath.isEmpty()
+                ? nullptr : resourceData(dictionaryPath, m_dictionaryCopy, &dictionarySize);
+            if (dictionary)
+                m_ddict = ZSTD_createDDict(dictionary, static_cast<size_t>(dictionarySize));
+#else
+            Q_UNUSED(dictionaryPath)
+            qWarning() << "Compressed content pack but built without ICONS_ZSTD:" << path;
+            m_data = nullptr;
+            m_count = 0;
+#endif
+        }
+    }
+
+    ~IconContentStore() {
+#ifdef ICONS_ZSTD
+        ZSTD_freeDDict(m_ddict);
+        ZSTD_freeDCtx(m_dctx);
+#endif
+    }
+
+    IconContentStore(const IconContentStore &) = delete;
+    IconContentStore &operator=(const IconContentStore &) = delete;
+
+    bool isValid() const { return m_data != nullptr; }
+    bool isCompressed() const { return m_version == c_versionZstd; }
+    int count() const { return m_count; }
+
+    // Stored bytes of an entry, viewed in place; for packs of binary records
+    // such as compiled paths. Empty if the store is invalid.
+    QByteArray blob(int index) const {
+        if (!isValid() || m_version != c_versionPlain)
+            return QByteArray();
+        return storedBody(index);
+    }
+
+    // UTF-8 body. Uncompressed packs return a view of the resource data
+    // (no copy); compressed packs decode the body.
+    QByteArray bodyUtf8(int index) const {
+        const QByteArray stored = storedBody(index);
+        if (m_version == c_versionPlain)
+            return stored;
+        QMutexLocker locker(&m_mutex);
+        return decode(stored);
+    }
+
+    // One store per pack, shared by every list of the library. Locks and
+    // looks the pack up by name, so callers resolve it once and keep the
+    // reference (generated lists use a function-local static).
+    static IconContentStore &shared(const QString &path, const QString &dictionaryPath = QString()) {
+        static QMutex mutex;
+        static std::map<QString, std::unique_ptr<IconContentStore>> stores;
+        QMutexLocker locker(&mutex);
+        auto &store = stores[path];
+        if (!store)
+            store.reset(new IconContentStore(path, dictionaryPath));
+        return *store;
+    }
+
+    // Body with the scale() wrapper the generator split off re-applied;
+    // an entities header, if present, stays in front
+    QString body(int index, const char *scale) const {
+        QString result = body(index);
+        if (!scale)
+            return result;
+        int insertAt = 0;
+        if (result.startsWith(QLatin1String("<!-- ENTITIES:"))) {
+            int end = result.indexOf(QLatin1String("-->\n"));
+            if (end >= 0)
+                insertAt = end + 4;
+        }
+        result.insert(insertAt, QLatin1String("<g transform=\"scale(") + QLatin1String(scale) + QLatin1String(")\">"));
+        result.append(QLatin1String("</g>"));
+        return result;
+    }
+
+    QString body(int index) const {
+        if (m_version == c_versionPlain)
+            return QString::fromUtf8(storedBody(index));
+
+        QMutexLocker locker(&m_mutex);
+        if (const QString *cached = m_decoded.object(index))
+            return *cached;
+        QString *decoded = new QString(QString::fromUtf8(decode(storedBody(index))));
+        const QString result = *decoded;
+        m_decoded.insert(index, decoded, qMax<qsizetype>(1, decoded->size() * 2));
+        return result;
+    }
+
+private:
+    static const uchar *resourceData(const QString &path, QByteArray &copy, qint64 *size) {
+        QResource resource(path);
+        if (!resource.isValid())
+            return nullptr;
+        if (resource.compressionAlgorithm() == QResource::NoCompression) {
+            *size = resource.size();
+            return resource.data();
+        }
+        // Still works if the resource got compressed, at the cost of one copy
+        copy = resource.uncompressedData();
+        *size = copy.size();
+        return reinterpret_cast<const uchar *>(copy.constData());
+    }
+
+    QByteArray storedBody(int index) const {
+        if (index < 0 || index >= m_count)
+            throw std::out_of_range("Requested icon index is out of range");
+        const quint32 begin = qFromLittleEndian<quint32>(m_offsets + index * 4);
+        const quint32 end = qFromLittleEndian<quint32>(m_offsets + (index + 1) * 4);
+        return QByteArray::fromRawData(reinterpret_cast<const char *>(m_bodies + begin), qsizetype(end - begin));
+    }
+
+#ifdef ICONS_ZSTD
+    // Caller holds m_mutex
+    QByteArray decode(const QByteArray &frame) const {
+        const unsigned long long size = ZSTD_getFrameContentSize(frame.constData(), frame.size());
+        if (size == ZSTD_CONTENTSIZE_ERROR || size == ZSTD_CONTENTSIZE_UNKNOWN)
+            return QByteArray();
+        QByteArray result(static_cast<qsizetype>(size), Qt::Uninitialized);
+        const size_t written = m_ddict
+            ? ZSTD_decompress_usingDDict(m_dctx, result.data(), result.size(), frame.constData(), frame.size(), m_ddict)
+            : ZSTD_decompressDCtx(m_dctx, result.data(), result.size(), frame.constData(), frame.size());
+        if (ZSTD_isError(written))
+            return QByteArray();
+        result.truncate(static_cast<qsizetype>(written));
+        return result;
+    }
+#else
+    QByteArray decode(const QByteArray &) const { return QByteArray(); }
+#endif
+
+    QByteArray m_copy;            // Only used for compressed resources
+    QByteArray m_dictionaryCopy;
+    const uchar *m_data = nullptr;
+    qint64 m_size = 0;
+    const uchar *m_offsets = nullptr;
+    const uchar *m_bodies = nullptr;
+    quint32 m_version = c_versionPlain;
+    int m_count = 0;
+
+    mutable QMutex m_mutex;       // Guards the decoder context and cache
+    mutable QCache<int, QString> m_decoded;
+#ifdef ICONS_ZSTD
+    ZSTD_DCtx *m_dctx = nullptr;
+    ZSTD_DDict *m_ddict = nullptr;
+#endif
+};
+
+// Paint of a list's getSource() wrapper, which compiled shapes inherit from
+struct CompiledPathStyle {
+    enum Paint : quint8 { Inherit, None, Current, Rgba };  // Current = the list's fill color
+
+    Paint fill = Current;
+    Paint stroke = None;
+    float strokeWidth = -1;  // Negative if the wrapper sets none (SVG default 1, not rescaled)
+    Qt::PenCapStyle cap = Qt::FlatCap;
+    Qt::PenJoinStyle join = Qt::MiterJoin;
+};
+
+// Implemented by generated lists whose icons were compiled to path records
+// by generator.py (content/svg_<library>.paths, see compiledpath.h). Icons
+// using SVG features the compiler does not handle have an empty record and
+// are rendered from their source as usual.
+class CompiledPathSource {
+public:
+    virtual ~CompiledPathSource() = default;
+
+    // Record of the icon, empty if not compiled. *scale receives the scale()
+    // wrapper of the icon's body, or nullptr.
+    virtual QByteArray getCompiledPaths(int index, const char **scale) const = 0;
+    virtual CompiledPathStyle getCompiledStyle() const = 0;
+};
+
+// Implemented by generated lists whose getSource() is a header that only
+// depends on the fill color, the icon's body and "</svg>". TwoToneIconList
+// composes its layers from these parts instead of splitting whole sources.
+class SvgSourceParts {
+public:
+    virtual ~SvgSourceParts() = default;
+
+    // "<svg ...>" of every icon's source for the current fill color
+    virtual QString getSourceHeader() const = 0;
+    // Body as getSource() embeds it, with list-specific rewrites applied
+    virtual QString getSourceBody(int index) const = 0;
+};
+
+#endif // LIB_CONTENTSTORE_H
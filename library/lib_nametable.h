@@ -0,0 +1,91 @@
+#ifndef LIB_NAMETABLE_H
+#define LIB_NAMETABLE_H
+
+/* Icon names of one generated list, emitted by generator.py
+ *
+ * All names are stored back to back as UTF-16 in a single pool, so a name
+ * can be handed out as a QStringView or a raw-data QString without any heap
+ * allocation. Alongside the pool the generator precomputes:
+ *   lengths  name length in UTF-16 units
+ *   hashes   FNV-1a over the ASCII-lowercased UTF-16 units of the name
+ * Every array carries one trailing sentinel so empty lists stay valid C. */
+typedef struct IconNameTableData {
+    const unsigned short *pool;
+    const unsigned int *offsets;
+    const unsigned short *lengths;
+    const unsigned int *hashes;
+    int count;
+} IconNameTableData;
+
+#ifdef __cplusplus
+
+#include <QString>
+#include <QStringView>
+
+class IconNameTable {
+public:
+    explicit IconNameTable(const IconNameTableData &data) : m_data(data) {}
+
+    int count() const { return m_data.count; }
+
+    QStringView name(int index) const {
+        return QStringView(chars(index), m_data.lengths[index]);
+    }
+
+    // Shares the generated pool; the string never owns or copies it
+    QString nameString(int index) const {
+        return QString::fromRawData(reinterpret_cast<const QChar *>(chars(index)), m_data.lengths[index]);
+    }
+
+    // Precomputed hashName() of the name
+    quint32 hash(int index) const { return m_data.hashes[index]; }
+
+    // Same hash as generator.py, consistent with compareFolded()
+    static quint32 hashName(QStringView name) {
+        quint32 h = 0x811c9dc5u;
+        for (QChar c : name) {
+            h ^= foldAscii(c.unicode());
+            h *= 0x01000193u;
+        }
+        return h;
+    }
+
+    // TwoTone matching key of a filled name, before case folding: "-fill" removed
+    static QStringView key(QStringView name) {
+        return name.endsWith(QLatin1String("-fill")) ? name.chopped(5) : name;
+    }
+
+    // Compares UTF-16 units after ASCII lowercasing, like the generator's name_key()
+    static int compareFolded(QStringView a, QStringView b) {
+        const qsizetype n = qMin(a.size(), b.size());
+        for (qsizetype i = 0; i < n; ++i) {
+            const char16_t ca = foldAscii(a[i].unicode());
+            const char16_t cb = foldAscii(b[i].unicode());
+            if (ca != cb)
+                return ca < cb ? -1 : 1;
+        }
+        return a.size() == b.size() ? 0 : (a.size() < b.size() ? -1 : 1);
+    }
+
+private:
+    static char16_t foldAscii(char16_t c) {
+        return (c >= u'A' && c <= u'Z') ? char16_t(c + (u'a' - u'A')) : c;
+    }
+
+    const char16_t *chars(int index) const {
+        return reinterpret_cast<const char16_t *>(m_data.pool) + m_data.offsets[index];
+    }
+
+    const IconNameTableData &m_data;
+};
+
+// Implemented by generated lists that carry a name table
+class IconNameSource {
+public:
+    virtual ~IconNameSource() = default;
+    virtual const IconNameTableData &getNameTable() const = 0;
+};
+
+#endif // __cplusplus
+
+#endif // LIB_NAMETABLE_H
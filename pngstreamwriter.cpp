@@ -0,0 +1,196 @@
+#include "pngstreamwriter.h"
+
+#include <QtEndian>
+
+#include <cstdlib>
+#include <cstring>
+
+static constexpr int BytesPerPixel = 4;
+static constexpr int FilterTypes = 5;                // None, Sub, Up, Average, Paeth
+static constexpr qsizetype ChunkSize = 256 * 1024;  // IDAT payload
+
+static uchar paeth(int left, int up, int upLeft) {
+	const int p = left + up - upLeft;
+	const int pa = std::abs(p - left);
+	const int pb = std::abs(p - up);
+	const int pc = std::abs(p - upLeft);
+	if (pa <= pb && pa <= pc)
+		return static_cast<uchar>(left);
+	return static_cast<uchar>(pb <= pc ? up : upLeft);
+}
+
+PngStreamWriter::~PngStreamWriter() {
+	abort();
+}
+
+bool PngStreamWriter::fail(const QString &error) {
+	m_error = error;
+	abort();
+	return false;
+}
+
+bool PngStreamWriter::open(const QString &path, int width, int height, int level) {
+	abort();
+	m_error.clear();
+	if (width <= 0 || height <= 0)
+		return fail(QString("invalid image size %1x%2").arg(width).arg(height));
+
+	m_file.setFileName(path);
+	if (!m_file.open(QIODevice::WriteOnly))
+		return fail(m_file.errorString());
+
+	m_stream = z_stream {};
+	if (deflateInit(&m_stream, level) != Z_OK)
+		return fail("deflateInit failed");
+	m_deflating = true;
+	m_width = width;
+	m_height = height;
+	m_row = 0;
+
+	const qsizetype stride = qsizetype(width) * BytesPerPixel;
+	m_previous.assign(stride, 0);
+	m_filtered.assign((stride + 1) * FilterTypes, 0);
+	m_output.resize(ChunkSize);
+	m_stream.next_out = m_output.data();
+	m_stream.avail_out = static_cast<uInt>(m_output.size());
+
+	static const uchar signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+	uchar header[13];
+	qToBigEndian<quint32>(width, header);
+	qToBigEndian<quint32>(height, header + 4);
+	header[8] = 8;   // Bit depth
+	header[9] = 6;   // RGBA
+	header[10] = 0;  // Deflate
+	header[11] = 0;  // Adaptive filtering
+	header[12] = 0;  // No interlace
+	if (m_file.write(reinterpret_cast<const char *>(signature), 8) != 8 || !writeChunk("IHDR", header, 13))
+		return fail(m_file.errorString());
+	return true;
+}
+
+bool PngStreamWriter::writeRows(const uchar *bits, qsizetype bytesPerLine, int rows) {
+	if (!m_deflating)
+		return false;
+	if (m_row + rows > m_height)
+		return fail(QString("%1 rows written to an image of %2").arg(m_row + rows).arg(m_height));
+
+	const qsizetype stride = qsizetype(m_width) * BytesPerPixel;
+	for (int y = 0; y < rows; ++y) {
+		const uchar *row = bits + y * bytesPerLine;
+		const uchar *up = m_previous.data();
+
+		// Filter the row every way, keep the one with the smallest sum of
+		// absolute values as signed bytes
+		int best = 0;
+		quint64 bestSum = ~quint64(0);
+		for (int type = 0; type < FilterTypes; ++type) {
+			uchar *out = m_filtered.data() + type * (stride + 1);
+			out[0] = static_cast<uchar>(type);
+			quint64 sum = 0;
+			for (qsizetype i = 0; i < stride; ++i) {
+				const int left = i >= BytesPerPixel ? row[i - BytesPerPixel] : 0;
+				const int upLeft = i >= BytesPerPixel ? up[i - BytesPerPixel] : 0;
+				int predictor = 0;
+				switch (type) {
+					case 1: predictor = left; break;
+					case 2: predictor = up[i]; break;
+					case 3: predictor = (left + up[i]) / 2; break;
+					case 4: predictor = paeth(left, up[i], upLeft); break;
+					default: break;
+				}
+				const uchar value = static_cast<uchar>(row[i] - predictor);
+				out[i + 1] = value;
+				sum += value < 128 ? value : 256 - value;
+			}
+			if (sum < bestSum) {
+				bestSum = sum;
+				best = type;
+			}
+		}
+
+		m_stream.next_in = m_filtered.data() + best * (stride + 1);
+		m_stream.avail_in = static_cast<uInt>(stride + 1);
+		if (!deflateInput(Z_NO_FLUSH))
+			return false;
+		std::memcpy(m_previous.data(), row, stride);
+		++m_row;
+	}
+	return true;
+}
+
+bool PngStreamWriter::deflateInput(int flush) {
+	for (;;) {
+		const int result = deflate(&m_stream, flush);
+		if (result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR)
+			return fail(QString("deflate failed (%1)").arg(result));
+
+		// A full buffer becomes one IDAT chunk
+		const qsizetype produced = qsizetype(m_output.size()) - m_stream.avail_out;
+		if (m_stream.avail_out == 0 || (result == Z_STREAM_END && produced > 0)) {
+			if (!writeChunk("IDAT", m_output.data(), produced))
+				return fail(m_file.errorString());
+			m_stream.next_out = m_output.data();
+			m_stream.avail_out = static_cast<uInt>(m_output.size());
+		}
+
+		if (flush == Z_FINISH ? result == Z_STREAM_END : m_stream.avail_in == 0 && m_stream.avail_out > 0)
+			return true;
+	}
+}
+
+bool PngStreamWriter::writeChunk(const char *type, const uchar *data, qsizetype size) {
+	uchar length[4];
+	qToBigEndian<quint32>(static_cast<quint32>(size), length);
+	uLong crc = crc32(0L, reinterpret_cast<const Bytef *>(type), 4);
+	if (size > 0)
+		crc = crc32(crc, data, static_cast<uInt>(size));
+	uchar checksum[4];
+	qToBigEndian<quint32>(static_cast<quint32>(crc), checksum);
+
+	return m_file.write(reinterpret_cast<const char *>(length), 4) == 4
+		&& m_file.write(type, 4) == 4
+		&& (size == 0 || m_file.write(reinterpret_cast<const char *>(data), size) == size)
+		&& m_file.write(reinterpret_cast<const char *>(checksum), 4) == 4;
+}
+
+bool PngStreamWriter::close() {
+	if (!m_deflating)
+		return false;
+	if (m_row != m_height)
+		return fail(QString("only %1 of %2 rows written").arg(m_row).arg(m_height));
+
+	m_stream.next_in = nullptr;
+	m_stream.avail_in = 0;
+	if (!deflateInput(Z_FINISH))
+		return false;
+	deflateEnd(&m_stream);
+	m_deflating = false;
+	m_output = {};
+	m_filtered = {};
+	m_previous = {};
+
+	if (!writeChunk("IEND", nullptr, 0)) {
+		m_error = m_file.errorString();
+		abort();
+		return false;
+	}
+	if (!m_file.commit()) {
+		m_error = m_file.errorString();
+		return false;
+	}
+	return true;
+}
+
+void PngStreamWriter::abort() {
+	if (m_deflating) {
+		deflateEnd(&m_stream);
+		m_deflating = false;
+	}
+	if (m_file.isOpen()) {
+		m_file.cancelWriting();
+		m_file.commit();  // Discards the temporary file
+	}
+	m_output = {};
+	m_filtered = {};
+	m_previous = {};
+}
@@ -0,0 +1,57 @@
+#ifndef PNGSTREAMWRITER_H
+#define PNGSTREAMWRITER_H
+
+#include <QSaveFile>
+#include <QString>
+
+#include <vector>
+
+#include <zlib.h>
+
+// PNG encoder fed in bands of rows, so an image never has to exist in
+// memory as a whole
+//
+// Rows are 8-bit non-premultiplied RGBA (QImage::Format_RGBA8888), given
+// top to bottom. Each row gets the adaptive filter libpng uses by default
+// (smallest sum of absolute differences over the five filter types) and goes
+// straight into one deflate stream, which is written out as IDAT chunks
+// as its buffer fills. Memory use is a few rows plus the deflate window.
+// Not thread-safe, but any one thread may drive it at a time.
+class PngStreamWriter {
+public:
+	PngStreamWriter() = default;
+	~PngStreamWriter();
+
+	PngStreamWriter(const PngStreamWriter &) = delete;
+	PngStreamWriter &operator=(const PngStreamWriter &) = delete;
+
+	// Writes the signature and header
+	bool open(const QString &path, int width, int height, int level = Z_DEFAULT_COMPRESSION);
+	bool writeRows(const uchar *bits, qsizetype bytesPerLine, int rows);
+	// Completes and commits the file; fails if rows are missing
+	bool close();
+	// Drops the partial file
+	void abort();
+
+	bool isOpen() const { return m_deflating; }
+	int rowsWritten() const { return m_row; }
+	QString errorString() const { return m_error; }
+
+private:
+	bool writeChunk(const char *type, const uchar *data, qsizetype size);
+	bool deflateInput(int flush);
+	bool fail(const QString &error);
+
+	QSaveFile m_file;
+	z_stream m_stream {};
+	bool m_deflating = false;
+	int m_width = 0;
+	int m_height = 0;
+	int m_row = 0;
+	std::vector<uchar> m_previous;  // Unfiltered previous row, zeros above the first
+	std::vector<uchar> m_filtered;  // Filter byte + row, one per filter type
+	std::vector<uchar> m_output;    // Deflate output of the next IDAT chunk
+	QString m_error;
+};
+
+#endif // PNGSTREAMWRITER_H
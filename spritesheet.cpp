@@ -0,0 +1,153 @@
+#include "spritesheet.h"
+
+#include <QFile>
+#include <QHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRegularExpression>
+#include <QTextStream>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+// ============================================================================
+// SpriteSheetLayout
+// ============================================================================
+
+SpriteSheetLayout::SpriteSheetLayout(const QList<QSize> &sizes, int padding)
+	: m_padding(qMax(0, padding))
+{
+	m_rects.resize(sizes.size());
+	if (sizes.isEmpty())
+		return;
+
+	QList<int> order(sizes.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&sizes](int a, int b) {
+		if (sizes[a].height() != sizes[b].height())
+			return sizes[a].height() > sizes[b].height();
+		return sizes[a].width() > sizes[b].width();
+	});
+
+	qint64 area = 0;
+	int maxWidth = 0;
+	for (const QSize &size : sizes) {
+		area += qint64(size.width() + m_padding) * (size.height() + m_padding);
+		maxWidth = qMax(maxWidth, size.width());
+	}
+	const int rowWidth = qMax(maxWidth, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(area)))));
+
+	int x = 0;
+	int y = 0;
+	int rowHeight = 0;
+	for (int index : order) {
+		const QSize size = sizes[index];
+		if (x > 0 && x + size.width() > rowWidth) {
+			y += rowHeight + m_padding;
+			x = 0;
+			rowHeight = 0;
+		}
+		if (x == 0) {
+			if (!m_rows.isEmpty())
+				m_rows.last().height = y - m_rows.last().y;
+			m_rows.append({ y, 0, {} });
+		}
+		m_rows.last().sprites.append(index);
+		m_rects[index] = QRect(QPoint(x, y), size);
+		m_size = m_size.expandedTo(QSize(x + size.width(), y + size.height()));
+		x += size.width() + m_padding;
+		rowHeight = qMax(rowHeight, size.height());
+	}
+	m_rows.last().height = m_size.height() - m_rows.last().y;
+}
+
+QRect SpriteSheetLayout::rect(int index, int scale) const {
+	const QRect &rect = m_rects[index];
+	return QRect(rect.topLeft() * scale, rect.size() * scale);
+}
+
+// ============================================================================
+// Index files
+// ============================================================================
+
+QStringList spriteKeys(const QStringList &names) {
+	static const QRegularExpression invalidChars("[^a-z0-9_-]+");
+	QStringList keys;
+	keys.reserve(names.size());
+	QHash<QString, int> used;
+	for (const QString &name : names) {
+		QString key = name.toLower().replace(invalidChars, "-");
+		if (key.isEmpty())
+			key = "icon";
+		const int seen = ++used[key];
+		if (seen > 1) {
+			QString unique;
+			int suffix = seen;
+			do {
+				unique = QString("%1-%2").arg(key).arg(suffix++);
+			} while (used.contains(unique));
+			used.insert(unique, 1);
+			key = unique;
+		}
+		keys.append(key);
+	}
+	return keys;
+}
+
+bool writeSpriteJson(const QString &path, const QString &imageFile, const QStringList &keys,
+					 const SpriteSheetLayout &layout, int scale) {
+	QJsonObject frames;
+	for (int i = 0; i < layout.count(); ++i) {
+		const QRect rect = layout.rect(i, scale);
+		frames.insert(keys[i], QJsonObject {
+			{ "frame", QJsonObject { { "x", rect.x() }, { "y", rect.y() },
+									 { "w", rect.width() }, { "h", rect.height() } } }
+		});
+	}
+	const QSize size = layout.size(scale);
+	const QJsonObject meta {
+		{ "image", imageFile },
+		{ "size", QJsonObject { { "w", size.width() }, { "h", size.height() } } },
+		{ "scale", scale },
+		{ "padding", layout.padding() * scale }
+	};
+
+	QFile file(path);
+	if (!file.open(QIODevice::WriteOnly))
+		return false;
+	const QByteArray json = QJsonDocument(QJsonObject { { "frames", frames }, { "meta", meta } }).toJson();
+	return file.write(json) == json.size();
+}
+
+bool writeSpriteCss(const QString &path, const QStringList &imageFiles, const QList<int> &scales,
+					const QStringList &keys, const SpriteSheetLayout &layout) {
+	QFile file(path);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+		return false;
+
+	QStringList imageSet;
+	for (int i = 0; i < imageFiles.size(); ++i)
+		imageSet.append(QString("url(\"%1\") %2x").arg(imageFiles[i]).arg(scales[i]));
+
+	QTextStream out(&file);
+	const QSize size = layout.size();
+	out << "/* Sprite sheet, " << layout.count() << " icons */\n"
+		<< ".icon {\n"
+		<< "\tdisplay: inline-block;\n"
+		<< "\tbackground-image: url(\"" << imageFiles.value(0) << "\");\n";
+	if (imageFiles.size() > 1)
+		out << "\tbackground-image: image-set(" << imageSet.join(", ") << ");\n";
+	out << "\tbackground-repeat: no-repeat;\n"
+		<< "\tbackground-size: " << size.width() << "px " << size.height() << "px;\n"
+		<< "}\n";
+
+	for (int i = 0; i < layout.count(); ++i) {
+		const QRect rect = layout.rect(i);
+		out << ".icon-" << keys[i] << " { width: " << rect.width() << "px; height: " << rect.height()
+			<< "px; background-position: " << -rect.x() << (rect.x() ? "px " : " ")
+			<< -rect.y() << (rect.y() ? "px" : "") << "; }\n";
+	}
+	out.flush();
+	return file.error() == QFileDevice::NoError;
+}
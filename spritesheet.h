@@ -0,0 +1,57 @@
+#ifndef SPRITESHEET_H
+#define SPRITESHEET_H
+
+#include <QList>
+#include <QRect>
+#include <QSize>
+#include <QString>
+#include <QStringList>
+
+// Placement of sprites on one sheet, in 1x pixels
+//
+// Shelf packing: sprites are taken tallest first and placed left to right
+// on rows about as wide as the square root of their total area, so mixed
+// sizes leave little empty space. padding separates neighbours only, not
+// the sheet edges. Scaled sheets multiply every coordinate, so one layout
+// and one CSS index serve all scales.
+class SpriteSheetLayout {
+public:
+	// One shelf: sprites sharing a band of rows
+	struct Row {
+		int y = 0;
+		int height = 0;      // Up to the next row, including the padding
+		QList<int> sprites;  // Indexes as passed in
+	};
+
+	SpriteSheetLayout() = default;
+	SpriteSheetLayout(const QList<QSize> &sizes, int padding);
+
+	int count() const { return m_rects.size(); }
+	int padding() const { return m_padding; }
+
+	// Rects are in the order of the sizes passed in
+	QRect rect(int index, int scale = 1) const;
+	QSize size(int scale = 1) const { return m_size * scale; }
+	const QList<Row> &rows() const { return m_rows; }
+
+private:
+	QList<QRect> m_rects;
+	QList<Row> m_rows;
+	QSize m_size;
+	int m_padding = 0;
+};
+
+// Index keys for icon names: lowercase, CSS-safe and unique ("home", "home-2")
+QStringList spriteKeys(const QStringList &names);
+
+// Frame index of the sheet at one scale, TexturePacker-style "hash" JSON:
+// { "frames": { key: { "frame": { x, y, w, h } } }, "meta": { image, size, scale } }
+bool writeSpriteJson(const QString &path, const QString &imageFile, const QStringList &keys,
+					 const SpriteSheetLayout &layout, int scale);
+
+// Stylesheet with one ".icon-<key>" class per sprite, in 1x CSS pixels.
+// imageFiles[i] is the sheet for scales[i]; they are offered via image-set().
+bool writeSpriteCss(const QString &path, const QStringList &imageFiles, const QList<int> &scales,
+					const QStringList &keys, const SpriteSheetLayout &layout);
+
+#endif // SPRITESHEET_H
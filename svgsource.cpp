@@ -0,0 +1,291 @@
+#include "svgsource.h"
+
+#include <cctype>
+#include <cstring>
+
+static const char c_fillSentinel[] = "#fe01fd";
+static const char c_toneSentinel[] = "#fd02fe";
+static const char c_strokeWidthAttr[] = "stroke-width=\"";
+
+static const double c_absStrokeWidths[] = { 0.0, 0.25, 0.5, 1.0, 1.25, 1.5 };
+static const double c_strokeScales[] = { 0.5, 0.75, 1.0, 1.25, 1.5 };
+
+// Returns false if the value has to stay as written
+static bool mappedStrokeWidth(double width, bool parsed, int sliderPos, bool fillBased, double *result) {
+	if (fillBased) {
+		*result = c_absStrokeWidths[qBound(0, sliderPos, 5)];
+		return true;
+	}
+	if (!parsed || sliderPos == 2)  // 1x scale, no change needed
+		return false;
+	*result = qMax(0.25, width * c_strokeScales[qBound(0, sliderPos, 4)]);  // Minimum stroke width
+	return true;
+}
+
+// Formatted like the original regex chain, QString::arg(double)
+static QString strokeWidthText(double width) {
+	return QStringLiteral("%1").arg(width);
+}
+
+static bool isStrokeWidthValue(QStringView value) {
+	if (value.isEmpty())
+		return false;
+	for (QChar ch : value) {
+		if (!ch.isDigit() && ch != QLatin1Char('.'))
+			return false;
+	}
+	return true;
+}
+
+// ============================================================================
+// rewriteSvg
+// ============================================================================
+
+namespace {
+
+class SvgRewriter {
+public:
+	SvgRewriter(QStringView source, const SvgRewriteOptions &options)
+		: m_source(source), m_options(options)
+	{
+		m_out.reserve(source.size() + source.size() / 8);
+	}
+
+	QByteArray run() {
+		static const QLatin1String strokeAttr("stroke-width=\"");
+		static const QLatin1String currentColor("currentColor");
+
+		// Unchanged text is copied in runs between substitutions
+		qsizetype pos = 0;
+		qsizetype runStart = 0;
+		const qsizetype size = m_source.size();
+		while (pos < size) {
+			const QChar ch = m_source[pos];
+			if (ch == QLatin1Char('&') && m_options.entities) {
+				qsizetype end = pos;
+				if (const QString *value = entityAt(pos, &end)) {
+					appendText(m_source.sliced(runStart, pos - runStart));
+					appendEntity(*value);
+					pos = runStart = end;
+					continue;
+				}
+			} else if (ch == QLatin1Char('s') && m_options.strokeSliderPos >= 0
+					   && m_source.sliced(pos).startsWith(strokeAttr)) {
+				appendText(m_source.sliced(runStart, pos - runStart));
+				pos = runStart = appendStrokeWidth(pos + strokeAttr.size());
+				continue;
+			} else if (ch == QLatin1Char('c') && !m_options.currentColor.isEmpty()
+					   && m_source.sliced(pos).startsWith(currentColor)) {
+				appendText(m_source.sliced(runStart, pos - runStart));
+				appendText(m_options.currentColor);
+				pos = runStart = pos + currentColor.size();
+				continue;
+			}
+			++pos;
+		}
+		appendText(m_source.sliced(runStart));
+		return m_out;
+	}
+
+private:
+	// Value of a known &name; reference at pos, with *end set after the ';'
+	const QString *entityAt(qsizetype pos, qsizetype *end) const {
+		const qsizetype semicolon = m_source.indexOf(QLatin1Char(';'), pos + 1);
+		if (semicolon < 0 || semicolon - pos > 64)
+			return nullptr;
+		auto it = m_options.entities->constFind(m_source.sliced(pos + 1, semicolon - pos - 1).toString());
+		if (it == m_options.entities->constEnd())
+			return nullptr;
+		*end = semicolon + 1;
+		return &it.value();
+	}
+
+	// The old chain resolved entities before mapping stroke widths and
+	// currentColor, so substituted text is rewritten like the source
+	void appendEntity(const QString &value) {
+		SvgRewriteOptions options = m_options;
+		options.entities = nullptr;  // Values are substituted once, not recursively
+		m_out += SvgRewriter(value, options).run();
+	}
+
+	// Entity values go through the same currentColor substitution
+	QString resolvedEntity(const QString &value) const {
+		if (m_options.currentColor.isEmpty() || !value.contains(QLatin1String("currentColor")))
+			return value;
+		return QString(value).replace(QLatin1String("currentColor"), m_options.currentColor);
+	}
+
+	// Rewrites one stroke-width="..." value starting at valueStart
+	qsizetype appendStrokeWidth(qsizetype valueStart) {
+		m_out += "stroke-width=\"";
+		const qsizetype valueEnd = m_source.indexOf(QLatin1Char('"'), valueStart);
+		if (valueEnd < 0)
+			return valueStart;
+
+		// Entity references inside the value resolve first, as in the old chain
+		QString value;
+		qsizetype pos = valueStart;
+		while (pos < valueEnd) {
+			qsizetype end = pos;
+			if (m_source[pos] == QLatin1Char('&') && m_options.entities) {
+				if (const QString *entity = entityAt(pos, &end)) {
+					value += resolvedEntity(*entity);
+					pos = end;
+					continue;
+				}
+			}
+			value += m_source[pos++];
+		}
+
+		double result = 0.0;
+		bool parsed = false;
+		if (isStrokeWidthValue(value)) {
+			double width = value.toDouble(&parsed);
+			if (mappedStrokeWidth(width, parsed, m_options.strokeSliderPos, m_options.fillBasedStroke, &result))
+				value = strokeWidthText(result);
+		}
+		appendText(value);
+		m_out += '"';
+		return valueEnd + 1;
+	}
+
+	// UTF-8 encodes text onto the output. Runs always start and end at ASCII
+	// characters, so surrogate pairs are never split between two calls.
+	void appendText(QStringView text) {
+		for (qsizetype i = 0; i < text.size(); ++i) {
+			char32_t code = text[i].unicode();
+			if (code < 0x80) {
+				m_out += char(code);
+				continue;
+			}
+			if (QChar::isSurrogate(code)) {
+				if (QChar::isHighSurrogate(code) && i + 1 < text.size() && text[i + 1].isLowSurrogate())
+					code = QChar::surrogateToUcs4(char16_t(code), text[++i].unicode());
+				else
+					code = QChar::ReplacementCharacter;
+			}
+			if (code < 0x800) {
+				m_out += char(0xc0 | (code >> 6));
+			} else if (code < 0x10000) {
+				m_out += char(0xe0 | (code >> 12));
+				m_out += char(0x80 | ((code >> 6) & 0x3f));
+			} else {
+				m_out += char(0xf0 | (code >> 18));
+				m_out += char(0x80 | ((code >> 12) & 0x3f));
+				m_out += char(0x80 | ((code >> 6) & 0x3f));
+			}
+			m_out += char(0x80 | (code & 0x3f));
+		}
+	}
+
+	QStringView m_source;
+	const SvgRewriteOptions &m_options;
+	QByteArray m_out;
+};
+
+} // namespace
+
+QByteArray rewriteSvg(QStringView source, const SvgRewriteOptions &options) {
+	return SvgRewriter(source, options).run();
+}
+
+double strokeWidthForSlider(double width, int sliderPos, bool fillBased) {
+	double result = width;
+	if (sliderPos >= 0)
+		mappedStrokeWidth(width, true, sliderPos, fillBased, &result);
+	return result;
+}
+
+// ============================================================================
+// SvgTemplate
+// ============================================================================
+
+static bool matchAt(const QByteArray &text, int pos, const char *pattern, int length) {
+	return pos + length <= text.size() && std::memcmp(text.constData() + pos, pattern, length) == 0;
+}
+
+SvgTemplate SvgTemplate::compile(const QByteArray &text, const QString &body) {
+	SvgTemplate result;
+	if (text.isEmpty()
+		|| body.contains(QLatin1String(c_fillSentinel), Qt::CaseInsensitive)
+		|| body.contains(QLatin1String(c_toneSentinel), Qt::CaseInsensitive))
+		return result;
+
+	const int colorLength = sizeof(c_fillSentinel) - 1;
+	const int attrLength = sizeof(c_strokeWidthAttr) - 1;
+	result.m_literal.reserve(text.size());
+
+	int pos = 0;
+	while (pos < text.size()) {
+		if (matchAt(text, pos, c_fillSentinel, colorLength)) {
+			result.m_slots.push_back({ SlotType::Fill, int(result.m_literal.size()), QByteArray() });
+			pos += colorLength;
+			continue;
+		}
+		if (matchAt(text, pos, c_toneSentinel, colorLength)) {
+			result.m_slots.push_back({ SlotType::Tone, int(result.m_literal.size()), QByteArray() });
+			pos += colorLength;
+			continue;
+		}
+		if (matchAt(text, pos, c_strokeWidthAttr, attrLength)) {
+			// Same match as rewriteSvg(): stroke-width="([0-9.]+)"
+			int valueStart = pos + attrLength;
+			int valueEnd = valueStart;
+			while (valueEnd < text.size() && (std::isdigit(uchar(text[valueEnd])) || text[valueEnd] == '.'))
+				++valueEnd;
+			if (valueEnd > valueStart && valueEnd < text.size() && text[valueEnd] == '"') {
+				result.m_literal.append(text.constData() + pos, attrLength);
+				result.m_slots.push_back({ SlotType::StrokeWidth, int(result.m_literal.size()),
+										   text.mid(valueStart, valueEnd - valueStart) });
+				pos = valueEnd;
+				continue;
+			}
+		}
+		result.m_literal.append(text[pos]);
+		++pos;
+	}
+
+	result.m_valid = true;
+	return result;
+}
+
+QByteArray SvgTemplate::instantiate(const QByteArray &fillColor, const QByteArray &toneColor,
+									int strokeSliderPos, bool fillBasedStroke) const {
+	// Fill-based widths do not depend on the original value
+	double absWidth = 0.0;
+	mappedStrokeWidth(0.0, true, strokeSliderPos, true, &absWidth);
+	const QByteArray absText = strokeWidthText(absWidth).toLatin1();
+
+	QByteArray out;
+	out.reserve(m_literal.size() + int(m_slots.size()) * 8);
+
+	int pos = 0;
+	for (const Slot &slot : m_slots) {
+		out.append(m_literal.constData() + pos, slot.offset - pos);
+		pos = slot.offset;
+
+		switch (slot.type) {
+			case SlotType::Fill:
+				out.append(fillColor);
+				break;
+			case SlotType::Tone:
+				out.append(toneColor);
+				break;
+			case SlotType::StrokeWidth:
+				if (fillBasedStroke) {
+					out.append(absText);
+				} else {
+					bool parsed = false;
+					double width = slot.original.toDouble(&parsed);
+					double result = 0.0;
+					if (mappedStrokeWidth(width, parsed, strokeSliderPos, false, &result))
+						out.append(strokeWidthText(result).toLatin1());
+					else
+						out.append(slot.original);
+				}
+				break;
+		}
+	}
+	out.append(m_literal.constData() + pos, m_literal.size() - pos);
+	return out;
+}
@@ -0,0 +1,69 @@
+#ifndef SVGSOURCE_H
+#define SVGSOURCE_H
+
+#include <QByteArray>
+#include <QColor>
+#include <QString>
+
+#include <vector>
+
+#include "library/lib_svgiconlist.h"
+
+// Options for rewriteSvg()
+struct SvgRewriteOptions {
+	int strokeSliderPos = -1;      // -1 leaves stroke-width values untouched
+	bool fillBasedStroke = true;   // true = absolute values, false = relative scaling
+	QString currentColor;          // Replacement for "currentColor", empty to keep it
+	const EntityMap *entities = nullptr;  // &name; references to resolve
+};
+
+// Single pass over the source applying entity resolution, the stroke slider
+// and currentColor substitution, written as UTF-8 into one preallocated
+// buffer that goes to QSvgRenderer as is. Substituted entity values are
+// rewritten too, as when entities were resolved before the regex chain.
+// Stroke slider mapping: fill-based icons get absolute values 0, 0.25, 0.5,
+// 1, 1.25, 1.5; stroke-based ones are scaled 0.5x-1.5x with a 0.25 minimum.
+QByteArray rewriteSvg(QStringView source, const SvgRewriteOptions &options);
+
+// Stroke width after applying the stroke slider with the same mapping;
+// sliderPos -1 returns the width unchanged
+double strokeWidthForSlider(double width, int sliderPos, bool fillBased);
+
+// Pre-scanned SVG source with fill, tone and stroke-width values cut out
+//
+// Compiled once per icon from a getSource() generated with sentinel colors.
+// Changing the fill/tone color or the stroke slider then only splices new
+// values into the UTF-8 text: no getSource() assembly, entity resolution,
+// regex pass or QString conversion per render.
+class SvgTemplate {
+public:
+	// Colors substituted into getSource() before compiling; never used by icons
+	static QColor fillSentinel() { return QColor(0xfe, 0x01, 0xfd); }
+	static QColor toneSentinel() { return QColor(0xfd, 0x02, 0xfe); }
+
+	// text is the UTF-8 source; returns an invalid template if the icon body
+	// already uses a sentinel
+	static SvgTemplate compile(const QByteArray &text, const QString &body);
+
+	bool isValid() const { return m_valid; }
+	int size() const { return m_literal.size(); }
+
+	// fillColor/toneColor are "#rrggbb" strings as produced by QColor::name()
+	QByteArray instantiate(const QByteArray &fillColor, const QByteArray &toneColor,
+						   int strokeSliderPos, bool fillBasedStroke) const;
+
+private:
+	enum class SlotType : quint8 { Fill, Tone, StrokeWidth };
+
+	struct Slot {
+		SlotType type;
+		int offset;           // Insert position in m_literal
+		QByteArray original;  // StrokeWidth only: value as written in the source
+	};
+
+	QByteArray m_literal;     // Source with all slot values removed
+	std::vector<Slot> m_slots;
+	bool m_valid = false;
+};
+
+#endif // SVGSOURCE_H
@@ -0,0 +1,241 @@
+#include "svgsprite.h"
+
+#include <QRegularExpression>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+
+// Root attributes that describe the document rather than the drawing
+static bool isDocumentAttribute(QStringView name) {
+	return name.startsWith(u"xmlns") || name == u"width" || name == u"height" || name == u"x"
+		|| name == u"y" || name == u"id" || name == u"class" || name == u"version";
+}
+
+// Copies the element at the reader's start tag with its children and
+// collects the ids it declares. If topId is given, the element's own id is
+// left out and returned there. Leaves the reader on the matching end tag.
+static void copyElement(QXmlStreamReader &reader, QXmlStreamWriter &writer, QStringList *ids,
+						QString *topId = nullptr) {
+	int depth = 0;
+	do {
+		switch (reader.tokenType()) {
+			case QXmlStreamReader::StartElement:
+				writer.writeStartElement(reader.qualifiedName().toString());
+				for (const auto &attribute : reader.attributes()) {
+					const QString name = attribute.qualifiedName().toString();
+					if (name.startsWith("xmlns"))
+						continue;
+					if (name == "id") {
+						if (depth == 0 && topId) {
+							*topId = attribute.value().toString();
+							continue;
+						}
+						ids->append(attribute.value().toString());
+					}
+					writer.writeAttribute(name, attribute.value().toString());
+				}
+				++depth;
+				break;
+			case QXmlStreamReader::EndElement:
+				writer.writeEndElement();
+				--depth;
+				break;
+			case QXmlStreamReader::Characters:
+				if (!reader.isWhitespace())
+					writer.writeCharacters(reader.text().toString());
+				break;
+			default:
+				break;
+		}
+		if (depth > 0)
+			reader.readNext();
+	} while (depth > 0 && !reader.atEnd() && !reader.hasError());
+}
+
+// Rewrites id="x", href="#x" and url(#x) through the map. Markup comes from
+// QXmlStreamWriter, so attributes are always double-quoted.
+static QString remapIds(const QString &markup, const QHash<QString, QString> &ids) {
+	if (ids.isEmpty())
+		return markup;
+	static const QRegularExpression references("(\\sid=\"|href=\"#|url\\(#|url\\('#)([^\"')\\s]+)");
+	QString result;
+	result.reserve(markup.size() + markup.size() / 8);
+	qsizetype last = 0;
+	auto it = references.globalMatch(markup);
+	while (it.hasNext()) {
+		const auto match = it.next();
+		const auto mapped = ids.constFind(match.captured(2));
+		if (mapped == ids.constEnd())
+			continue;
+		result += QStringView(markup).mid(last, match.capturedStart(2) - last);
+		result += mapped.value();
+		last = match.capturedEnd(2);
+	}
+	result += QStringView(markup).mid(last);
+	return result;
+}
+
+// Whether the markup has an href="#x" or url(#x) reference to one of the ids
+static bool referencesAny(const QString &markup, const QSet<QString> &ids) {
+	if (ids.isEmpty())
+		return false;
+	static const QRegularExpression references("(href=\"#|url\\(#|url\\('#)([^\"')\\s]+)");
+	auto it = references.globalMatch(markup);
+	while (it.hasNext()) {
+		if (ids.contains(it.next().captured(2)))
+			return true;
+	}
+	return false;
+}
+
+// ============================================================================
+// SvgSpriteBuilder
+// ============================================================================
+
+SvgSpriteBuilder::Icon SvgSpriteBuilder::parseIcon(const QString &svg) {
+	Icon icon;
+	QXmlStreamReader reader(svg);
+	reader.setNamespaceProcessing(false);  // Keep "xlink:href" as written
+
+	while (!reader.atEnd() && !reader.isStartElement())
+		reader.readNext();
+	if (!reader.isStartElement() || reader.qualifiedName() != u"svg")
+		return icon;
+
+	QString width;
+	QString height;
+	for (const auto &attribute : reader.attributes()) {
+		const QStringView name = attribute.qualifiedName();
+		if (name == u"viewBox")
+			icon.viewBox = attribute.value().toString();
+		else if (name == u"width")
+			width = attribute.value().toString().remove("px");
+		else if (name == u"height")
+			height = attribute.value().toString().remove("px");
+		else if (!isDocumentAttribute(name))
+			icon.attributes.append({ name.toString(), attribute.value().toString() });
+	}
+	if (icon.viewBox.isEmpty() && !width.isEmpty() && !height.isEmpty())
+		icon.viewBox = QString("0 0 %1 %2").arg(width, height);
+
+	QXmlStreamWriter writer(&icon.body);
+	while (!reader.atEnd()) {
+		reader.readNext();
+		if (reader.isEndElement())
+			break;  // </svg>; children are consumed by copyElement()
+		if (!reader.isStartElement())
+			continue;
+		if (reader.qualifiedName() == u"defs") {
+			while (reader.readNextStartElement()) {
+				Icon::Def def;
+				QXmlStreamWriter defWriter(&def.markup);
+				copyElement(reader, defWriter, &icon.ids, &def.id);
+				if (def.id.isEmpty())
+					icon.localDefs += def.markup;  // Nothing can reference it; it stays with the icon
+				else
+					icon.defs.push_back(std::move(def));
+			}
+		} else {
+			copyElement(reader, writer, &icon.ids);
+		}
+	}
+	icon.valid = !reader.hasError();
+	return icon;
+}
+
+QString SvgSpriteBuilder::uniqueId(const QString &id) {
+	QString unique = id;
+	for (int suffix = 2; m_usedIds.contains(unique); ++suffix)
+		unique = QString("%1-%2").arg(id).arg(suffix);
+	m_usedIds.insert(unique);
+	return unique;
+}
+
+void SvgSpriteBuilder::reserveSymbolIds(const QStringList &ids) {
+	for (const QString &id : ids) {
+		if (!m_usedIds.contains(id)) {
+			m_usedIds.insert(id);
+			m_reservedIds.insert(id);
+		}
+	}
+}
+
+void SvgSpriteBuilder::addIcon(const QString &id, const Icon &icon) {
+	const QString symbolId = m_reservedIds.remove(id) ? id : uniqueId(id);
+
+	QHash<QString, QString> ids;
+	for (const QString &local : icon.ids)
+		ids.insert(local, uniqueId(symbolId + "-" + local));
+
+	// Identical defs share the first icon's copy. They are compared after
+	// remapping, so a def is only keyed once every def it references has its
+	// final id: defs are resolved in dependency order. Nested ids remap to
+	// this symbol, so defs containing them are never shared; defs left in a
+	// reference cycle are not shared either.
+	std::vector<const Icon::Def *> pending;
+	QSet<QString> pendingIds;
+	for (const auto &def : icon.defs) {
+		pending.push_back(&def);
+		pendingIds.insert(def.id);
+	}
+	std::vector<std::pair<QString, QString>> hoisted;  // Id, remapped markup
+	for (bool resolved = true; resolved && !pending.empty();) {
+		resolved = false;
+		for (auto it = pending.begin(); it != pending.end();) {
+			const Icon::Def *def = *it;
+			if (referencesAny(def->markup, pendingIds)) {
+				++it;
+				continue;
+			}
+			const QString markup = remapIds(def->markup, ids);
+			const auto shared = m_sharedDefs.constFind(markup);
+			if (shared != m_sharedDefs.constEnd()) {
+				ids.insert(def->id, shared.value());
+			} else {
+				const QString defId = uniqueId(symbolId + "-" + def->id);
+				ids.insert(def->id, defId);
+				m_sharedDefs.insert(markup, defId);
+				hoisted.emplace_back(defId, markup);
+			}
+			pendingIds.remove(def->id);
+			it = pending.erase(it);
+			resolved = true;
+		}
+	}
+	for (const Icon::Def *def : pending)
+		ids.insert(def->id, uniqueId(symbolId + "-" + def->id));
+	for (const Icon::Def *def : pending)
+		hoisted.emplace_back(ids.value(def->id), remapIds(def->markup, ids));
+
+	for (auto &[defId, markup] : hoisted) {
+		// Put the id back right after the tag name
+		qsizetype nameEnd = 1;
+		while (nameEnd < markup.size() && !markup[nameEnd].isSpace()
+			   && markup[nameEnd] != '/' && markup[nameEnd] != '>')
+			++nameEnd;
+		m_defs.append(markup.insert(nameEnd, QString(" id=\"%1\"").arg(defId)));
+	}
+
+	QString symbol = QString("<symbol id=\"%1\"").arg(symbolId.toHtmlEscaped());
+	if (!icon.viewBox.isEmpty())
+		symbol += QString(" viewBox=\"%1\"").arg(icon.viewBox.toHtmlEscaped());
+	for (const auto &attribute : icon.attributes)
+		symbol += QString(" %1=\"%2\"").arg(attribute.first, attribute.second.toHtmlEscaped());
+	symbol += '>';
+	if (!icon.localDefs.isEmpty())
+		symbol += "<defs>" + remapIds(icon.localDefs, ids) + "</defs>";
+	symbol += remapIds(icon.body, ids);
+	symbol += "</symbol>";
+	m_symbols.append(symbol);
+}
+
+QByteArray SvgSpriteBuilder::toSvg() const {
+	QString svg;
+	svg.reserve(1024);
+	svg += "<svg xmlns=\"http://www.w3.org/2000/svg\" xmlns:xlink=\"http://www.w3.org/1999/xlink\">\n";
+	if (!m_defs.isEmpty())
+		svg += "<defs>\n" + m_defs.join('\n') + "\n</defs>\n";
+	for (const QString &symbol : m_symbols)
+		svg += symbol + '\n';
+	svg += "</svg>\n";
+	return svg.toUtf8();
+}
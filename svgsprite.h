@@ -0,0 +1,59 @@
+#ifndef SVGSPRITE_H
+#define SVGSPRITE_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QPair>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+#include <vector>
+
+// SVG sprite: one <symbol> per icon, used as <svg><use href="icons.svg#home"/></svg>
+//
+// Icons are parsed independently with parseIcon(), which is thread-safe, and
+// then added in order. Every id inside an icon is prefixed with its symbol id
+// so icons cannot clash. Top-level <defs> children with an id are hoisted
+// into one shared <defs>, and identical ones (gradients, clip paths repeated
+// across icons) are written once; defs are compared with their references
+// resolved, so two defs only match if everything they point to does too.
+class SvgSpriteBuilder {
+public:
+	struct Icon {
+		struct Def {
+			QString id;
+			QString markup;  // Element without its id attribute
+		};
+
+		QString viewBox;
+		QList<QPair<QString, QString>> attributes;  // Root presentation attributes
+		std::vector<Def> defs;
+		QString localDefs;   // <defs> children without an id, kept in the symbol
+		QString body;
+		QStringList ids;     // Ids declared outside the hoisted defs
+		bool valid = false;
+	};
+
+	// icon is a complete SVG document, e.g. from IconModel::getIconSvg()
+	static Icon parseIcon(const QString &svg);
+
+	// Keeps ids for symbols added later, so prefixed local ids of earlier
+	// icons cannot take them; addIcon() then uses a reserved id unchanged
+	void reserveSymbolIds(const QStringList &ids);
+	void addIcon(const QString &id, const Icon &icon);
+	int count() const { return m_symbols.size(); }
+
+	QByteArray toSvg() const;
+
+private:
+	QString uniqueId(const QString &id);
+
+	QStringList m_defs;
+	QStringList m_symbols;
+	QHash<QString, QString> m_sharedDefs;  // Remapped def markup -> hoisted id
+	QSet<QString> m_usedIds;
+	QSet<QString> m_reservedIds;  // Reserved symbol ids not added yet
+};
+
+#endif // SVGSPRITE_H
@@ -0,0 +1,283 @@
+#include "thumbnailcache.h"
+
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <algorithm>
+#include <vector>
+
+// ============================================================================
+// ThumbnailPixmapCache
+// ============================================================================
+
+ThumbnailPixmapCache::ThumbnailPixmapCache(qint64 maxBytes)
+	: m_maxBytes(maxBytes)
+{
+}
+
+qint64 ThumbnailPixmapCache::cost(const QPixmap &pixmap) {
+	return qint64(pixmap.width()) * pixmap.height() * qMax(1, pixmap.depth()) / 8;
+}
+
+const QPixmap *ThumbnailPixmapCache::find(const IconRenderKey &key) {
+	auto it = m_index.constFind(key);
+	if (it == m_index.constEnd()) {
+		++m_stats.misses;
+		return nullptr;
+	}
+	++m_stats.hits;
+	m_lru.splice(m_lru.begin(), m_lru, it.value());
+	return &m_lru.front().second;
+}
+
+bool ThumbnailPixmapCache::contains(const IconRenderKey &key) const {
+	return m_index.contains(key);
+}
+
+void ThumbnailPixmapCache::insert(const IconRenderKey &key, const QPixmap &pixmap) {
+	remove(key);
+	if (pixmap.isNull() || cost(pixmap) > m_maxBytes)
+		return;
+
+	m_lru.emplace_front(key, pixmap);
+	m_index.insert(key, m_lru.begin());
+	m_bytes += cost(pixmap);
+	evict();
+}
+
+void ThumbnailPixmapCache::remove(const IconRenderKey &key) {
+	auto it = m_index.find(key);
+	if (it == m_index.end())
+		return;
+	m_bytes -= cost(it.value()->second);
+	m_lru.erase(it.value());
+	m_index.erase(it);
+}
+
+void ThumbnailPixmapCache::clear() {
+	m_lru.clear();
+	m_index.clear();
+	m_bytes = 0;
+}
+
+void ThumbnailPixmapCache::setMaxBytes(qint64 bytes) {
+	m_maxBytes = bytes;
+	evict();
+}
+
+void ThumbnailPixmapCache::evict() {
+	while (m_bytes > m_maxBytes && !m_lru.empty()) {
+		const Entry &oldest = m_lru.back();
+		m_bytes -= cost(oldest.second);
+		m_index.remove(oldest.first);
+		m_lru.pop_back();
+		++m_stats.evictions;
+	}
+}
+
+// ============================================================================
+// ThumbnailDiskCache
+// ============================================================================
+
+// Bump whenever rendering output changes, so stale thumbnails are discarded
+static const quint32 c_cacheVersion = 1;
+static const quint32 c_indexMagic = 0x49435443;  // "ICTC"
+
+ThumbnailDiskCache &ThumbnailDiskCache::instance() {
+	static ThumbnailDiskCache cache;
+	return cache;
+}
+
+ThumbnailDiskCache::ThumbnailDiskCache() {
+	m_dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/thumbnails";
+	loadIndex();
+
+	if (auto *app = QCoreApplication::instance()) {
+		QObject::connect(app, &QCoreApplication::aboutToQuit, app, [this]() { flush(); });
+	}
+}
+
+QString ThumbnailDiskCache::fileKey(const IconRenderKey &key, const QByteArray &svg) {
+	QCryptographicHash hash(QCryptographicHash::Sha1);
+	hash.addData(QByteArray::number(c_cacheVersion));
+	hash.addData(key.libraryName.toUtf8());
+	QByteArray params = QByteArray::number(key.index) + '|'
+		+ QByteArray::number(key.cellSize) + '|'
+		+ QByteArray::number(key.fillColor, 16) + '|'
+		+ QByteArray::number(key.toneColor, 16) + '|'
+		+ QByteArray::number(key.backgroundColor, 16) + '|'
+		+ QByteArray::number(key.strokeWidth) + '|'
+		+ (key.fillBasedStroke ? "f" : "s") + '|'
+		+ QByteArray::number(key.entitiesHash) + '|'
+		+ (key.grayscale ? "g" : "c");
+	hash.addData(params);
+	hash.addData(svg);  // Content hash of the resolved source
+	return QString::fromLatin1(hash.result().toHex());
+}
+
+QString ThumbnailDiskCache::filePath(const QString &fileKey) const {
+	// Two-level layout keeps directories small on large collections
+	return m_dir + '/' + fileKey.left(2) + '/' + fileKey + ".png";
+}
+
+QImage ThumbnailDiskCache::load(const QString &fileKey) {
+	QString path = filePath(fileKey);
+	QImage image;
+	if (!image.load(path, "PNG")) {
+		QMutexLocker locker(&m_mutex);
+		auto it = m_entries.find(fileKey);
+		if (it != m_entries.end()) {
+			m_totalSize -= it->size;
+			m_entries.erase(it);
+			m_dirty = true;
+		}
+		return QImage();
+	}
+
+	QMutexLocker locker(&m_mutex);
+	auto it = m_entries.find(fileKey);
+	if (it == m_entries.end()) {
+		// File survived a crash before the index was written
+		Entry entry;
+		entry.size = QFileInfo(path).size();
+		m_totalSize += entry.size;
+		it = m_entries.insert(fileKey, entry);
+	}
+	it->lastUsed = QDateTime::currentMSecsSinceEpoch();
+	m_dirty = true;
+	locker.unlock();
+
+	return image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+}
+
+void ThumbnailDiskCache::store(const QString &fileKey, const QImage &image) {
+	if (image.isNull())
+		return;
+
+	QString path = filePath(fileKey);
+	QDir().mkpath(QFileInfo(path).absolutePath());
+
+	QSaveFile file(path);
+	if (!file.open(QIODevice::WriteOnly) || !image.save(&file, "PNG") || !file.commit()) {
+		qWarning() << "Thumbnail cache: failed to write" << path;
+		return;
+	}
+
+	const qint64 fileSize = QFileInfo(path).size();
+
+	QMutexLocker locker(&m_mutex);
+	Entry &entry = m_entries[fileKey];
+	m_totalSize += fileSize - entry.size;
+	entry.size = fileSize;
+	entry.lastUsed = QDateTime::currentMSecsSinceEpoch();
+	m_dirty = true;
+
+	if (m_totalSize > m_maxSize)
+		prune();
+}
+
+void ThumbnailDiskCache::setMaxSize(qint64 bytes) {
+	QMutexLocker locker(&m_mutex);
+	m_maxSize = bytes;
+	if (m_totalSize > m_maxSize)
+		prune();
+}
+
+qint64 ThumbnailDiskCache::maxSize() const {
+	QMutexLocker locker(&m_mutex);
+	return m_maxSize;
+}
+
+qint64 ThumbnailDiskCache::size() const {
+	QMutexLocker locker(&m_mutex);
+	return m_totalSize;
+}
+
+void ThumbnailDiskCache::flush() {
+	QMutexLocker locker(&m_mutex);
+	if (m_dirty)
+		saveIndex();
+}
+
+void ThumbnailDiskCache::clear() {
+	QMutexLocker locker(&m_mutex);
+	QDir(m_dir).removeRecursively();
+	m_entries.clear();
+	m_totalSize = 0;
+	m_dirty = true;
+}
+
+void ThumbnailDiskCache::prune() {
+	// Drop least recently used entries down to 90% of the budget
+	std::vector<std::pair<qint64, QString>> byAge;
+	byAge.reserve(m_entries.size());
+	for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it)
+		byAge.emplace_back(it->lastUsed, it.key());
+	std::sort(byAge.begin(), byAge.end());
+
+	const qint64 target = m_maxSize / 10 * 9;
+	for (const auto &item : byAge) {
+		if (m_totalSize <= target)
+			break;
+		QFile::remove(filePath(item.second));
+		m_totalSize -= m_entries.value(item.second).size;
+		m_entries.remove(item.second);
+	}
+	m_dirty = true;
+}
+
+void ThumbnailDiskCache::loadIndex() {
+	QFile file(m_dir + "/index.dat");
+	if (!file.open(QIODevice::ReadOnly))
+		return;
+
+	QDataStream in(&file);
+	in.setVersion(QDataStream::Qt_6_0);
+	quint32 magic = 0, version = 0;
+	in >> magic >> version;
+	if (magic != c_indexMagic || version != c_cacheVersion) {
+		// Thumbnails from another renderer version are useless
+		file.close();
+		QDir(m_dir).removeRecursively();
+		return;
+	}
+
+	qint32 count = 0;
+	in >> count;
+	m_entries.reserve(count);
+	for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+		QString key;
+		Entry entry;
+		in >> key >> entry.size >> entry.lastUsed;
+		m_entries.insert(key, entry);
+		m_totalSize += entry.size;
+	}
+}
+
+void ThumbnailDiskCache::saveIndex() {
+	QDir().mkpath(m_dir);
+	QSaveFile file(m_dir + "/index.dat");
+	if (!file.open(QIODevice::WriteOnly)) {
+		qWarning() << "Thumbnail cache: failed to write" << file.fileName();
+		return;
+	}
+
+	QDataStream out(&file);
+	out.setVersion(QDataStream::Qt_6_0);
+	out << c_indexMagic << c_cacheVersion << qint32(m_entries.size());
+	for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it)
+		out << it.key() << it->size << it->lastUsed;
+
+	if (file.commit())
+		m_dirty = false;
+	else
+		qWarning() << "Thumbnail cache: failed to write" << file.fileName();
+}
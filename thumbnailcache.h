@@ -0,0 +1,139 @@
+#ifndef THUMBNAILCACHE_H
+#define THUMBNAILCACHE_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+#include <QPixmap>
+#include <QString>
+#include <QtGlobal>
+
+#include <list>
+#include <utility>
+
+// Everything a rendered thumbnail depends on besides the SVG source itself
+struct IconRenderKey {
+	QString libraryName;        // Collection, style and icon size (e.g. "Tabler Outline 24")
+	int index = -1;             // Icon index within the list
+	int cellSize = 0;           // Rendered pixel size
+	QRgb fillColor = 0;
+	QRgb toneColor = 0;
+	QRgb backgroundColor = 0;
+	int strokeWidth = 0;        // Slider position
+	bool fillBasedStroke = true;
+	quint32 entitiesHash = 0;   // Custom entity overrides, 0 if none
+	bool grayscale = false;     // Bitmap collections only
+	bool compiledPaths = false; // Compiled path records allowed (IconModel::setCompiledPathsEnabled)
+
+	bool isValid() const { return !libraryName.isEmpty() && index >= 0 && cellSize > 0; }
+
+	bool operator==(const IconRenderKey &other) const {
+		return index == other.index && cellSize == other.cellSize
+			&& fillColor == other.fillColor && toneColor == other.toneColor
+			&& backgroundColor == other.backgroundColor
+			&& strokeWidth == other.strokeWidth && fillBasedStroke == other.fillBasedStroke
+			&& entitiesHash == other.entitiesHash && grayscale == other.grayscale
+			&& compiledPaths == other.compiledPaths
+			&& libraryName == other.libraryName;
+	}
+	bool operator!=(const IconRenderKey &other) const { return !(*this == other); }
+};
+
+inline size_t qHash(const IconRenderKey &key, size_t seed = 0) {
+	return qHashMulti(seed, key.libraryName, key.index, key.cellSize,
+					  key.fillColor, key.toneColor, key.backgroundColor,
+					  key.strokeWidth, key.fillBasedStroke, key.entitiesHash, key.grayscale,
+					  key.compiledPaths);
+}
+
+// In-memory LRU of thumbnails, bounded by pixel memory rather than entry count
+//
+// Keyed by the full render parameters, so switching back to a previous color,
+// size or collection hits instead of re-rendering. GUI thread only.
+class ThumbnailPixmapCache {
+public:
+	struct Stats {
+		quint64 hits = 0;
+		quint64 misses = 0;
+		quint64 evictions = 0;
+	};
+
+	explicit ThumbnailPixmapCache(qint64 maxBytes = 64 * 1024 * 1024);
+
+	// Returns nullptr on a miss; the pointer is valid until the next insert
+	const QPixmap *find(const IconRenderKey &key);
+	bool contains(const IconRenderKey &key) const;  // Does not touch LRU order or stats
+
+	void insert(const IconRenderKey &key, const QPixmap &pixmap);
+	void remove(const IconRenderKey &key);
+	void clear();
+
+	void setMaxBytes(qint64 bytes);
+	qint64 maxBytes() const { return m_maxBytes; }
+	qint64 bytes() const { return m_bytes; }
+	int count() const { return static_cast<int>(m_index.size()); }
+
+	Stats stats() const { return m_stats; }
+	void resetStats() { m_stats = Stats(); }
+
+private:
+	using Entry = std::pair<IconRenderKey, QPixmap>;
+	using LruList = std::list<Entry>;  // Most recently used at the front
+
+	static qint64 cost(const QPixmap &pixmap);
+	void evict();
+
+	LruList m_lru;
+	QHash<IconRenderKey, LruList::iterator> m_index;
+	qint64 m_maxBytes;
+	qint64 m_bytes = 0;
+	Stats m_stats;
+};
+
+// Persistent PNG thumbnail store in the platform cache directory
+//
+// Entries are named by a SHA-1 over the render key and the resolved SVG
+// source, so any change to the source invalidates them without bookkeeping.
+// A small versioned index tracks sizes and last use for LRU pruning; it is
+// written on application exit. Safe to call from render workers.
+class ThumbnailDiskCache {
+public:
+	static ThumbnailDiskCache &instance();
+
+	static QString fileKey(const IconRenderKey &key, const QByteArray &svg);
+
+	QImage load(const QString &fileKey);
+	void store(const QString &fileKey, const QImage &image);
+
+	void setMaxSize(qint64 bytes);
+	qint64 maxSize() const;
+	qint64 size() const;
+
+	void flush();
+	void clear();
+
+private:
+	ThumbnailDiskCache();
+	ThumbnailDiskCache(const ThumbnailDiskCache &) = delete;
+	ThumbnailDiskCache &operator=(const ThumbnailDiskCache &) = delete;
+
+	struct Entry {
+		qint64 size = 0;
+		qint64 lastUsed = 0;
+	};
+
+	QString filePath(const QString &fileKey) const;
+	void loadIndex();
+	void saveIndex();
+	void prune();  // Expects m_mutex to be held
+
+	QString m_dir;
+	QHash<QString, Entry> m_entries;
+	qint64 m_totalSize = 0;
+	qint64 m_maxSize = 256 * 1024 * 1024;
+	bool m_dirty = false;
+	mutable QMutex m_mutex;
+};
+
+#endif // THUMBNAILCACHE_H